@@ -0,0 +1,110 @@
+/**
+ * @file binary.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for BINARY class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "binary.hpp"
+
+// Initialize the static member variables outside the class definition
+const std::string_view BINARY::magic = "PWMODELS";
+const std::uint32_t BINARY::version = 1;
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+bool BINARY::isBinary(std::string_view data) {
+  return data.substr(0, magic.size()) == magic;
+}
+
+std::uint64_t BINARY::checksum(std::string_view data, std::uint64_t value) {
+  for (unsigned char c : data) {
+    value = (value ^ c) * 1099511628211ull;
+  }
+  return value;
+}
+
+void BINARY::putInteger(std::string &out, std::uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+bool BINARY::getInteger(std::string_view data, std::size_t &position,
+                        int bytes, std::uint64_t &value) {
+  if (position > data.size() || data.size() - position < std::size_t(bytes)) {
+    return false;
+  }
+  value = 0;
+  for (int i = 0; i < bytes; i++) {
+    value |= std::uint64_t(static_cast<unsigned char>(data[position + i]))
+             << (8 * i);
+  }
+  position += bytes;
+  return true;
+}
+
+bool BINARY::readHeader(std::string_view data, HEADER &header) {
+  if (!isBinary(data)) {
+    return false;
+  }
+  std::size_t position = magic.size();
+  std::uint64_t fileVersion, width, categories;
+  if (!getInteger(data, position, 4, fileVersion) || fileVersion != version ||
+      !getInteger(data, position, 4, width) || (width != 1 && width != 2) ||
+      !getInteger(data, position, 4, categories) || categories > data.size()) {
+    return false;
+  }
+  header.width = width;
+
+  // Names of the categories and their elements
+  auto getName = [&](std::string_view &name) {
+    std::uint64_t length;
+    if (!getInteger(data, position, 4, length) ||
+        length > data.size() - position) {
+      return false;
+    }
+    name = data.substr(position, length);
+    position += length;
+    return true;
+  };
+  header.categories.assign(categories, std::string_view());
+  header.elements.assign(categories, std::vector<std::string_view>());
+  for (std::uint64_t c = 0; c < categories; c++) {
+    std::uint64_t count;
+    if (!getName(header.categories[c]) ||
+        !getInteger(data, position, 4, count) || count > data.size()) {
+      return false;
+    }
+    header.elements[c].resize(count);
+    for (std::string_view &element : header.elements[c]) {
+      if (!getName(element)) {
+        return false;
+      }
+    }
+  }
+
+  // Rows have to fill the rest of the file up to the checksum
+  std::uint64_t rows, stored;
+  if (!getInteger(data, position, 8, rows) || data.size() - position < 8) {
+    return false;
+  }
+  header.rows = rows;
+  header.begin = position;
+  std::size_t rowSize = categories * width;
+  std::size_t end = data.size() - 8;
+  if (rowSize == 0 ? rows != 0 || end != position
+                   : (end - position) % rowSize != 0 ||
+                         (end - position) / rowSize != rows) {
+    return false;
+  }
+  position = end;
+  getInteger(data, position, 8, stored);
+  return checksum(data.substr(magic.size(), end - magic.size())) == stored;
+}
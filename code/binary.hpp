@@ -0,0 +1,135 @@
+/**
+ * @file binary.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for BINARY class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_BINARY
+#define PAIRWISE_BINARY
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Constants and encoding helpers of the binary models format
+ * @note A binary models file stores the names only once in its header,
+ * each row is a fixed number of element ids. All integers are little
+ * endian. Layout:
+ * - magic "PWMODELS" (8 bytes)
+ * - version (4 bytes)
+ * - width of an element id, 1 or 2 (4 bytes)
+ * - number of categories (4 bytes), then for each category its name, the
+ *   number of its elements (4 bytes) and the names of the elements. A name
+ *   is its length (4 bytes) followed by its characters.
+ * - number of rows (8 bytes)
+ * - rows, one element id per category in the order of the header
+ * - checksum (8 bytes), FNV-1a of everything between magic and checksum
+ *
+ * The files are written by PRETTYPRINT::printBinaryModels() and read by
+ * PARSER, which recognizes them by the magic.
+ */
+class BINARY {
+public:
+  /**
+   * @brief Contents of the header of a binary models file
+   */
+  struct HEADER {
+    /**
+     * @brief Bytes per element id, 1 or 2
+     */
+    int width;
+
+    /**
+     * @brief Names of the categories, pointing into the file
+     */
+    std::vector<std::string_view> categories;
+
+    /**
+     * @brief Names of the elements of each category, pointing into the file
+     */
+    std::vector<std::vector<std::string_view>> elements;
+
+    /**
+     * @brief Number of rows
+     */
+    std::size_t rows;
+
+    /**
+     * @brief Byte offset of the first row
+     */
+    std::size_t begin;
+  };
+
+  /**
+   * @brief First bytes of every binary models file
+   */
+  static const std::string_view magic;
+
+  /**
+   * @brief Version of the format written by this program
+   */
+  static const std::uint32_t version;
+
+  /**
+   * @brief Checks if a file starts with the magic of the binary format
+   *
+   * @param data contents of the file
+   * @return true if the file is in the binary format
+   * @return false otherwise
+   */
+  static bool isBinary(std::string_view data);
+
+  /**
+   * @brief Continues an FNV-1a checksum over some bytes
+   *
+   * @param data bytes to be added to the checksum
+   * @param value checksum of the preceding bytes, the default starts a new
+   * checksum
+   * @return std::uint64_t checksum including data
+   */
+  static std::uint64_t checksum(std::string_view data,
+                                std::uint64_t value = 14695981039346656037ull);
+
+  /**
+   * @brief Appends an integer in little endian byte order
+   *
+   * @param out buffer the integer is appended to
+   * @param value integer to be appended
+   * @param bytes number of bytes to be written
+   */
+  static void putInteger(std::string &out, std::uint64_t value, int bytes);
+
+  /**
+   * @brief Reads an integer in little endian byte order
+   *
+   * @param data contents of the file
+   * @param position position of the integer, moved behind it
+   * @param bytes number of bytes to be read
+   * @param value receives the integer
+   * @return true if the integer was read
+   * @return false if the data ends before the integer
+   */
+  static bool getInteger(std::string_view data, std::size_t &position,
+                         int bytes, std::uint64_t &value);
+
+  /**
+   * @brief Reads the header of a binary models file
+   * @note Also verifies that the rows fill the file up to the checksum and
+   * that the checksum matches, the element ids of the rows are not checked
+   *
+   * @param data contents of the file
+   * @param header receives the header
+   * @return true if the file is a valid binary models file
+   * @return false otherwise
+   */
+  static bool readHeader(std::string_view data, HEADER &header);
+};
+
+#endif
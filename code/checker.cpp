@@ -10,7 +10,21 @@
  */
 
 #include "checker.hpp"
+#include "checkpoint.hpp"
 #include "model.hpp"
+#include "parallel.hpp"
+#include "parser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+// Initialize the static member variable outside the class definition
+bool CHECKER::failFast = true;
+std::string CHECKER::reportFile;
 
 CHECKER::CHECKER() {}
 
@@ -20,28 +34,327 @@ CHECKER::~CHECKER() {}
 // Function Definitions                                                     //
 /////////////////////////////////////////////////////////////////////////////
 
-int CHECKER::check(MODEL *m, PROBLEM *p) {
-  // Run all subchecks and return result
+int CHECKER::check(MODEL *m, PROBLEM *p, int strength) {
+  // Check input files first, the models can only be checked against valid
+  // input files
   int inputFiles = checkInputFiles(p);
-  if (inputFiles) {
+  if (inputFiles && inputFiles != 100) {
     return inputFiles;
   }
 
-  int optionsValid = checkOptionsValid(m, p);
-  if (optionsValid) {
-    return optionsValid;
+  // Check all models in a single pass
+  int models = checkModels(m, p, strength);
+  if (models) {
+    return models;
   }
+  return inputFiles;
+}
+
+int CHECKER::checkStream(MODEL *m, PROBLEM *p, int strength) {
+  // Time each phase if a report is requested
+  REPORT report;
+  REPORT *metrics = reportFile.empty() ? nullptr : &report;
 
-  int optionCoverage = checkOptionCoverage(m, p);
-  if (optionCoverage) {
-    return optionCoverage;
+  // Check input files first, the models can only be checked against valid
+  // input files
+  report.startPhase("input files");
+  int inputFiles = checkInputFiles(p);
+  if (inputFiles && inputFiles != 100) {
+    return inputFiles;
   }
 
-  int constraints = checkConstraints(m, p);
-  if (constraints) {
-    return constraints;
+  // Get filename from model
+  std::string filename = m->getModelsFile();
+
+  // Translate problem to ids and set up bitmap
+  report.startPhase("dictionary");
+  DICTIONARY d;
+  int status = d.build(p);
+  if (status) {
+    return status;
   }
-  return 0;
+  COVERAGE coverage;
+  status = coverage.init(d, strength);
+  if (status) {
+    std::cerr << "Error: Invalid strength " << strength << "." << std::endl;
+    return status;
+  }
+  if (metrics) {
+    coverage.countHits();
+  }
+
+  // Check all rows as they are read
+  report.startPhase("rows");
+  std::size_t offset = 0;
+  std::size_t rows = 0;
+  int rowStatus = streamModels(d, coverage, filename, offset, rows, metrics);
+  if (rowStatus && !metrics) {
+    return rowStatus;
+  }
+
+  report.startPhase("infeasible combinations");
+  std::vector<std::size_t> infeasible;
+  status = findInfeasibleCombinations(d, strength, infeasible);
+  if (status && !rowStatus) {
+    return status;
+  }
+
+  // The report needs the bitmap before the infeasible combinations are
+  // marked in it. It is also written if a row is invalid, covering the rows
+  // checked until then.
+  report.stopPhase();
+  report.setStatus(rowStatus);
+  if (metrics && report.write(reportFile, filename, d, coverage, infeasible)) {
+    std::cerr << "Warning: Could not write " << reportFile << "."
+              << std::endl;
+  }
+  if (rowStatus) {
+    return rowStatus;
+  }
+
+  int models = reportCoverage(d, coverage, filename, &infeasible);
+  if (models) {
+    return models;
+  }
+  return inputFiles;
+}
+
+int CHECKER::checkSequence(
+    PROBLEM *p, int strength, const std::string &filename,
+    const std::function<const std::vector<std::string> *()> &next) {
+  // Translate problem to ids and set up bitmap
+  DICTIONARY d;
+  int status = d.build(p);
+  if (status) {
+    return status;
+  }
+  COVERAGE coverage;
+  status = coverage.init(d, strength);
+  if (status) {
+    std::cerr << "Error: Invalid strength " << strength << "." << std::endl;
+    return status;
+  }
+
+  // Check each row as it arrives, once a row failed in fail fast mode the
+  // remaining rows are only taken
+  int models = 0;
+  std::size_t rows = 0;
+  std::vector<int> ids;
+  while (const std::vector<std::string> *row = next()) {
+    rows++;
+    if (models && failFast) {
+      continue;
+    }
+    std::string error = checkRow(d, *row, rows, filename, ids);
+    if (error.empty()) {
+      coverage.addRow(ids);
+      continue;
+    }
+    std::cerr << error << std::endl;
+    models = 40;
+  }
+  if (models) {
+    return models;
+  }
+
+  return reportCoverage(d, coverage, filename);
+}
+
+int CHECKER::checkIncremental(MODEL *m, PROBLEM *p, int strength) {
+  // Get filename from model, stdin can not be continued later
+  std::string filename = m->getModelsFile();
+  if (filename == "-") {
+    return checkStream(m, p, strength);
+  }
+  std::string checkpointFile = filename + ".checkpoint";
+
+  // Check input files first, the models can only be checked against valid
+  // input files
+  int inputFiles = checkInputFiles(p);
+  if (inputFiles && inputFiles != 100) {
+    return inputFiles;
+  }
+
+  // Translate problem to ids and set up bitmap
+  DICTIONARY d;
+  int status = d.build(p);
+  if (status) {
+    return status;
+  }
+  COVERAGE coverage;
+  status = coverage.init(d, strength);
+  if (status) {
+    std::cerr << "Error: Invalid strength " << strength << "." << std::endl;
+    return status;
+  }
+
+  // Continue behind the rows of the checkpoint if it was made for the same
+  // input files, otherwise check the complete file
+  std::uint64_t optionsHash = CHECKPOINT::hash(p->getOptions());
+  std::uint64_t constraintsHash = CHECKPOINT::hash(p->getConstraints());
+  std::size_t offset = 0;
+  std::size_t rows = 0;
+  std::uint64_t fileHash = CHECKPOINT::emptyHash;
+  CHECKPOINT previous;
+  if (previous.read(checkpointFile) == 0 &&
+      previous.matches(strength, optionsHash, constraintsHash, filename) &&
+      coverage.setWords(previous.getBits())) {
+    offset = previous.getOffset();
+    rows = previous.getRows();
+    fileHash = previous.getFileHash();
+    LOGGER_INFO << "Continuing check of " << filename << " at row "
+                << rows + 1 << std::endl;
+  }
+
+  std::size_t checked = offset;
+  status = streamModels(d, coverage, filename, offset, rows);
+  if (status) {
+    return status;
+  }
+
+  // Only store the checkpoint if the file ends with a complete row, a
+  // partial row could still be extended. The hash of the checked part only
+  // has to be extended by the new rows.
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (file.is_open() && static_cast<std::size_t>(file.tellg()) == offset &&
+      CHECKPOINT::hashFile(filename, checked, offset, fileHash)) {
+    CHECKPOINT checkpoint(strength, optionsHash, constraintsHash, offset,
+                          fileHash, rows, coverage.getWords());
+    if (checkpoint.write(checkpointFile)) {
+      std::cerr << "Warning: Could not write " << checkpointFile << "."
+                << std::endl;
+    }
+  }
+
+  int models = reportCoverage(d, coverage, filename);
+  if (models) {
+    return models;
+  }
+  return inputFiles;
+}
+
+int CHECKER::diff(MODEL *before, MODEL *after, PROBLEM *p, int strength) {
+  // Check input files first, the models can only be checked against valid
+  // input files
+  int inputFiles = checkInputFiles(p);
+  if (inputFiles && inputFiles != 100) {
+    return inputFiles;
+  }
+
+  // Translate problem to ids and set up one bitmap per file
+  DICTIONARY d;
+  int status = d.build(p);
+  if (status) {
+    return status;
+  }
+  std::vector<std::string> filenames = {before->getModelsFile(),
+                                        after->getModelsFile()};
+  std::vector<COVERAGE> coverage(2);
+  for (auto &bitmap : coverage) {
+    status = bitmap.init(d, strength);
+    if (status) {
+      std::cerr << "Error: Invalid strength " << strength << "." << std::endl;
+      return status;
+    }
+  }
+
+  // Stream both files at the same time, every valid row is also stored as
+  // its element ids to find the rows contained in both files
+  std::vector<std::unordered_set<std::string>> keys(2);
+  std::vector<std::size_t> rows(2, 0);
+  std::vector<std::vector<std::string>> errors(2);
+  std::vector<int> results(2, 0);
+  PARALLEL::run(2, 1, [&](unsigned, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++) {
+      std::vector<int> ids;
+      results[i] = PARSER::visitIds(
+          filenames[i], d,
+          [&](const FIELDS &line, const std::vector<int> *translated) {
+            std::string error =
+                translated
+                    ? checkIds(d, *translated, ++rows[i], filenames[i])
+                    : checkRow(d, line, ++rows[i], filenames[i], ids);
+            if (!error.empty()) {
+              errors[i].push_back(error);
+              return failFast ? 40 : 0;
+            }
+            const std::vector<int> &row = translated ? *translated : ids;
+            coverage[i].addRow(row);
+            keys[i].emplace(reinterpret_cast<const char *>(row.data()),
+                            row.size() * sizeof(int));
+            return 0;
+          });
+    }
+  });
+
+  // Report errors of the old file first
+  int result = 0;
+  for (int i = 0; i < 2; i++) {
+    if (results[i] == 10) {
+      return 10;
+    }
+    for (const auto &error : errors[i]) {
+      std::cerr << error << std::endl;
+      result = 40;
+    }
+  }
+  if (result) {
+    return result;
+  }
+
+  // Turn the keys of the shared rows back into ids, sorted so that the
+  // output does not depend on the hash sets
+  std::vector<std::vector<int>> shared;
+  const auto &smaller = keys[0].size() < keys[1].size() ? keys[0] : keys[1];
+  const auto &larger = keys[0].size() < keys[1].size() ? keys[1] : keys[0];
+  for (const auto &key : smaller) {
+    if (larger.count(key)) {
+      shared.emplace_back(key.size() / sizeof(int));
+      std::memcpy(shared.back().data(), key.data(), key.size());
+    }
+  }
+  std::sort(shared.begin(), shared.end());
+  std::cout << "Rows in " << filenames[0] << ": " << rows[0] << std::endl;
+  std::cout << "Rows in " << filenames[1] << ": " << rows[1] << std::endl;
+  std::cout << "Rows in both files: " << shared.size() << std::endl;
+  for (const std::vector<int> &row : shared) {
+    for (int c = 0; c < d.getCategoryCount(); c++) {
+      std::cout << (c ? ", " : "") << d.getCategoryName(c) << " "
+                << d.getElementName(c, row[c]);
+    }
+    std::cout << std::endl;
+  }
+
+  // Combinations covered by exactly one of the files
+  std::vector<int> categories;
+  std::vector<int> elements;
+  for (int i = 0; i < 2; i++) {
+    std::vector<std::size_t> only;
+    for (std::size_t index = 0; index < coverage[i].getCount(); index++) {
+      if (coverage[i].isCovered(index) && !coverage[1 - i].isCovered(index)) {
+        only.push_back(index);
+      }
+    }
+    std::cout << (strength == 2 ? "Pairs" : "Combinations")
+              << " only covered by " << filenames[i] << ": " << only.size()
+              << std::endl;
+    for (std::size_t index : only) {
+      coverage[i].decode(index, categories, elements);
+      for (int j = 0; j < strength; j++) {
+        std::cout << (j ? ", " : "") << d.getCategoryName(categories[j])
+                  << " " << d.getElementName(categories[j], elements[j]);
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  return inputFiles;
+}
+
+void CHECKER::setFailFast(bool enabled) { failFast = enabled; }
+
+void CHECKER::setReportFile(const std::string &filename) {
+  reportFile = filename;
 }
 
 int CHECKER::checkFiles(PROBLEM *p) {
@@ -49,14 +362,229 @@ int CHECKER::checkFiles(PROBLEM *p) {
   return result;
 }
 
+int CHECKER::findInfeasiblePairs(
+    PROBLEM *p, std::vector<std::tuple<std::string, std::string, std::string,
+                                       std::string>> &infeasible) {
+  // Translate problem to ids
+  DICTIONARY d;
+  int status = d.build(p);
+  if (status) {
+    return status;
+  }
+
+  std::vector<std::size_t> indices;
+  status = findInfeasibleCombinations(d, 2, indices);
+  if (status) {
+    return status;
+  }
+
+  // Translate ids back to names
+  COVERAGE pairs;
+  pairs.init(d, 2);
+  std::vector<int> categories;
+  std::vector<int> elements;
+  for (std::size_t index : indices) {
+    pairs.decode(index, categories, elements);
+    infeasible.push_back(std::make_tuple(
+        d.getCategoryName(categories[0]),
+        d.getElementName(categories[0], elements[0]),
+        d.getCategoryName(categories[1]),
+        d.getElementName(categories[1], elements[1])));
+  }
+
+  return 0;
+}
+
+int CHECKER::findInfeasibleCombinations(const DICTIONARY &d, int strength,
+                                        std::vector<std::size_t> &infeasible) {
+  // Stores which combinations are known to be part of a valid row
+  COVERAGE feasible;
+  int status = feasible.init(d, strength);
+  if (status) {
+    return status;
+  }
+
+  std::vector<int> categories;
+  std::vector<int> elements;
+  for (std::size_t index = 0; index < feasible.getCount(); index++) {
+    // Combination was already found in a valid row
+    if (feasible.isCovered(index)) {
+      continue;
+    }
+
+    // Try to find a valid row containing the combination
+    feasible.decode(index, categories, elements);
+    std::vector<int> row(d.getCategoryCount(), -1);
+    bool valid = true;
+    for (int i = 0; i < strength && valid; i++) {
+      valid = !violatesConstraint(d, row, categories[i], elements[i]);
+      row[categories[i]] = elements[i];
+    }
+    if (valid) {
+      valid = completeRow(d, row);
+    }
+
+    if (!valid) {
+      infeasible.push_back(index);
+      continue;
+    }
+
+    // Every combination in the row that was found is feasible as well, this
+    // saves searching for most of the remaining combinations
+    feasible.addRow(row);
+  }
+
+  return 0;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Helper Functions                                                         //
 /////////////////////////////////////////////////////////////////////////////
 
+int CHECKER::checkModels(MODEL *m, PROBLEM *p, int strength) {
+  // Mapped models are checked without copying the rows
+  if (m->getTable()) {
+    return checkTable(*m->getTable(), m->getModelsFile(), p, strength);
+  }
+  return checkTable(m->getModels(), m->getModelsFile(), p, strength);
+}
+
+template <typename Rows>
+int CHECKER::checkTable(const Rows &models, const std::string &filename,
+                        PROBLEM *p, int strength) {
+  // Translate problem to ids once, this lookup table is used for all checks
+  DICTIONARY d;
+  int status = d.build(p);
+  if (status) {
+    return status;
+  }
+
+  // Each chunk of rows gets its own bitmap and buffer, so that the threads
+  // do not have to share anything they write to
+  std::vector<COVERAGE> coverage(PARALLEL::getThreads());
+  for (auto &bitmap : coverage) {
+    status = bitmap.init(d, strength);
+    if (status) {
+      std::cerr << "Error: Invalid strength " << strength << "." << std::endl;
+      return status;
+    }
+  }
+  std::vector<std::vector<int>> ids(coverage.size());
+  std::vector<std::vector<std::string_view>> fields(coverage.size());
+
+  // The first row of a columnar file is its header, the other rows are
+  // looked up column by column and are numbered without the header
+  std::vector<int> columns;
+  std::size_t first =
+      models.size() > 0 && d.compileHeader(models[0], columns) ? 1 : 0;
+
+  // Run all checks on each row and mark the combinations it covers
+  // Rows that could not be translated are checked again by name for the
+  // error message
+  status = checkRows(models.size() - first, [&](unsigned chunk,
+                                                std::size_t index) {
+    const auto &row = models[first + index];
+    std::string error;
+    if (!first) {
+      error = d.compileRow(row, ids[chunk])
+                  ? checkIds(d, ids[chunk], index + 1, filename)
+                  : checkRow(d, row, index + 1, filename, ids[chunk]);
+    } else if (d.compileColumns(row, columns, ids[chunk])) {
+      error = checkIds(d, ids[chunk], index + 1, filename);
+    } else {
+      d.expandColumns(row, columns, fields[chunk]);
+      error = checkRow(d,
+                       FIELDS(fields[chunk].data(),
+                              fields[chunk].data() + fields[chunk].size()),
+                       index + 1, filename, ids[chunk]);
+    }
+    if (error.empty()) {
+      coverage[chunk].addRow(ids[chunk]);
+    }
+    LOGGER_TRACE << "Checked row " << index + 1 << " of " << filename
+                 << (error.empty() ? "" : " with an error") << std::endl;
+    return error;
+  });
+  if (status) {
+    return status;
+  }
+
+  // Combine bitmaps of all chunks
+  for (std::size_t i = 1; i < coverage.size(); i++) {
+    coverage[0].merge(coverage[i]);
+  }
+  return reportCoverage(d, coverage[0], filename);
+}
+
+int CHECKER::streamModels(const DICTIONARY &d, COVERAGE &coverage,
+                          const std::string &filename, std::size_t &offset,
+                          std::size_t &rows, REPORT *report) {
+  // Run all checks on each row as soon as it is read, errors are printed
+  // right away since the rows arrive in order
+  std::vector<int> ids;
+  int models = 0;
+  int status = PARSER::visitIds(
+      filename, d,
+      [&](const FIELDS &line, const std::vector<int> *translated) {
+        // Rows that could not be translated are checked again by name for
+        // the error message
+        std::string error =
+            translated ? checkIds(d, *translated, ++rows, filename)
+                       : checkRow(d, line, ++rows, filename, ids);
+        if (error.empty()) {
+          std::size_t added = coverage.addRow(translated ? *translated : ids);
+          if (report) {
+            report->addRow(added);
+          }
+          return 0;
+        }
+        std::cerr << error << std::endl;
+        models = 40;
+        return failFast ? 40 : 0;
+      },
+      offset, &offset);
+  // Models file could not be opened
+  if (status == 10) {
+    return status;
+  }
+  return models;
+}
+
+int CHECKER::checkCoverage(MODEL *m, PROBLEM *p, int strength) {
+  const std::vector<std::vector<std::string>> &models = m->getModels();
+  // Get filename from model
+  std::string filename = m->getModelsFile();
+
+  // Translate problem to ids and set up bitmap
+  DICTIONARY d;
+  int status = d.build(p);
+  if (status) {
+    return status;
+  }
+  COVERAGE coverage;
+  status = coverage.init(d, strength);
+  if (status) {
+    std::cerr << "Error: Invalid strength " << strength << "." << std::endl;
+    return status;
+  }
+
+  // Mark combinations of each row that passes the checks of checkModels(),
+  // invalid rows are reported by the other checks
+  std::vector<int> ids;
+  for (std::size_t i = 0; i < models.size(); i++) {
+    if (checkRow(d, models[i], i + 1, filename, ids).empty()) {
+      coverage.addRow(ids);
+    }
+  }
+
+  return reportCoverage(d, coverage, filename);
+}
+
 int CHECKER::checkInputFiles(PROBLEM *p) {
   // Fetch options and constraints
-  std::vector<std::vector<std::string>> options = p->getOptions();
-  std::vector<std::vector<std::string>> constraints = p->getConstraints();
+  const std::vector<std::vector<std::string>> &options = p->getOptions();
+  const std::vector<std::vector<std::string>> &constraints =
+      p->getConstraints();
 
   int i = 0; // used to count rows for error messages
   int warning = 0;
@@ -68,17 +596,18 @@ int CHECKER::checkInputFiles(PROBLEM *p) {
   for (const auto row : options) {
     i++;
     if (row.size() < 3) {
-      LOGGER() << "Warning in row " << i << " of " << p->getOptionsFileIn()
-                << ": Each row should contain at least one category name "
-                   "and two elements"
-                << std::endl;
+      LOGGER_INFO << "Warning in row " << i << " of "
+                  << p->getOptionsFileIn()
+                  << ": Each row should contain at least one category name "
+                     "and two elements"
+                  << std::endl;
       warning = 100;
     }
     if (row.size() < 2) {
-      LOGGER() << "Error in row " << i << " of " << p->getOptionsFileIn()
-                << ": Each row must contain at least one category name "
-                   "and one element"
-                << std::endl;
+      LOGGER_INFO << "Error in row " << i << " of " << p->getOptionsFileIn()
+                  << ": Each row must contain at least one category name "
+                     "and one element"
+                  << std::endl;
       return 20;
     }
   }
@@ -103,12 +632,32 @@ int CHECKER::checkInputFiles(PROBLEM *p) {
   // Reset row counter
   i = 0;
   // Loop through the constraints and check for valid categories and elements
+  // Expressions are compiled against the names of the options only
+  DICTIONARY names;
+  bool namesBuilt = false;
+
   for (const auto &row : constraints) {
     i++;
+    if (EXPRESSION::isExpression(row)) {
+      if (!namesBuilt) {
+        names.build(options, {});
+        namesBuilt = true;
+      }
+      EXPRESSION rule;
+      std::string error;
+      if (rule.compile(EXPRESSION::join(row), names, error)) {
+        LOGGER_INFO << "Error in row " << i << " of "
+                    << p->getConstraintsFileIn() << ": " << error << std::endl;
+        return 30;
+      }
+      continue;
+    }
+
     // The constraints should contain an even number of elements
     if (row.size() % 2 != 0) {
-      LOGGER() << "Error in row " << i << " of " << p->getConstraintsFileIn()
-                << ": For each element there must be a category" << std::endl;
+      LOGGER_INFO << "Error in row " << i << " of "
+                  << p->getConstraintsFileIn()
+                  << ": For each element there must be a category" << std::endl;
       return 30;
     }
 
@@ -120,9 +669,10 @@ int CHECKER::checkInputFiles(PROBLEM *p) {
       // Check if the category exists in the map of valid categories
       auto categoryElementsIter = validCategoryElements.find(category);
       if (categoryElementsIter == validCategoryElements.end()) {
-        LOGGER() << "Error in row " << i << " of " << p->getConstraintsFileIn()
-                  << ": Invalid category name at position " << (j + 1)
-                  << std::endl;
+        LOGGER_INFO << "Error in row " << i << " of "
+                    << p->getConstraintsFileIn()
+                    << ": Invalid category name at position " << (j + 1)
+                    << std::endl;
         return 30;
       }
 
@@ -130,8 +680,9 @@ int CHECKER::checkInputFiles(PROBLEM *p) {
       const std::unordered_set<std::string> &validElements =
           categoryElementsIter->second;
       if (validElements.find(element) == validElements.end()) {
-        LOGGER() << "Error in row " << i << " of " << p->getConstraintsFileIn()
-                  << ": Invalid element at position " << (j + 2) << std::endl;
+        LOGGER_INFO << "Error in row " << i << " of "
+                    << p->getConstraintsFileIn()
+                    << ": Invalid element at position " << (j + 2) << std::endl;
         return 30;
       }
     }
@@ -141,187 +692,345 @@ int CHECKER::checkInputFiles(PROBLEM *p) {
 }
 
 int CHECKER::checkOptionCoverage(MODEL *m, PROBLEM *p) {
-  std::vector<std::vector<std::string>> options = p->getOptions();
-  std::vector<std::vector<std::string>> models = m->getModels();
+  const std::vector<std::vector<std::string>> &models = m->getModels();
   // Get filename from model
   std::string filename = m->getModelsFile();
 
-  // Create a map to store the elements for each category in options
-  std::unordered_map<std::string, std::vector<std::string>> categoryToElements;
+  // Only the options are needed to check the format of the rows
+  DICTIONARY d;
+  int status = d.build(p->getOptions(), {});
+  if (status) {
+    return status;
+  }
 
-  // Populate the map with data from options
-  for (const auto &row : options) {
-    if (row.size() >= 2) {
-      std::string category = row[0];
-      for (size_t i = 1; i < row.size(); i++) {
-        categoryToElements[category].push_back(row[i]);
-      }
-    }
+  // Buffer for each chunk of rows
+  std::vector<std::vector<int>> ids(PARALLEL::getThreads());
+
+  // Run the same format checks as checkModels() on each row
+  return checkRows(models.size(), [&](unsigned chunk, std::size_t index) {
+    return checkFormat(d, models[index], index + 1, filename, ids[chunk]);
+  });
+}
+
+int CHECKER::checkConstraints(MODEL *m, PROBLEM *p) {
+  const std::vector<std::vector<std::string>> &models = m->getModels();
+  // Get filename from model
+  std::string filename = m->getModelsFile();
+
+  // The dictionary contains an index from each element to the constraints
+  // that mention it, so each row only has to look at those constraints
+  DICTIONARY d;
+  int status = d.build(p);
+  if (status) {
+    return status;
   }
 
-  int row = 0;
-  // Check if each row in models contains an element and a category from options
-  for (const auto &modelRow : models) {
-    row++;
-    if (modelRow.size() % 2 != 0) {
-      // Each row in models must have an even number of elements (category,
-      // element, category, element, etc.)
-      std::cerr << "Error in row " << row << " of " << filename
-                << ". Each category must be paired with an element."
-                << std::endl;
-      return 40;
+  // Buffer for each chunk of rows
+  std::vector<std::vector<int>> ids(PARALLEL::getThreads());
+
+  // Look for rows in 'models' that contain a combination from a row of
+  // 'constraints', rows that can not be translated are reported by
+  // checkOptionCoverage()
+  return checkRows(models.size(), [&](unsigned chunk, std::size_t index) {
+    if (!d.compileRow(models[index], ids[chunk])) {
+      return std::string();
     }
+    return checkIds(d, ids[chunk], index + 1, filename);
+  });
+}
 
-    // Check if the number of categories in the current row matches the number
-    // of rows in options
-    if (modelRow.size() / 2 != options.size()) {
-      std::cerr << "Error in row " << row << " of " << filename
-                << ". Each row must contain the same amount of "
-                   "categories, as are defined in the options file."
-                << std::endl;
-      return 40;
+int CHECKER::checkOptionsValid(MODEL *m, PROBLEM *p) {
+  return checkOptionCoverage(m, p);
+}
+
+template <typename Row>
+std::string CHECKER::checkFormat(const DICTIONARY &d, const Row &modelRow,
+                                 std::size_t row, const std::string &filename,
+                                 std::vector<int> &ids) {
+  std::ostringstream error;
+
+  // Each row in models must have an even number of elements (category,
+  // element, category, element, etc.)
+  if (modelRow.size() % 2 != 0) {
+    error << "Error in row " << row << " of " << filename
+          << ". Each category must be paired with an element.";
+    return error.str();
+  }
+
+  // Check if the number of categories in the current row matches the number
+  // of rows in options
+  if (modelRow.size() / 2 != (std::size_t)d.getCategoryCount()) {
+    error << "Error in row " << row << " of " << filename
+          << ". Each row must contain the same amount of "
+             "categories, as are defined in the options file.";
+    return error.str();
+  }
+
+  // Translate row to ids, this checks categories and elements at once
+  ids.assign(d.getCategoryCount(), -1);
+  for (size_t i = 0; i < modelRow.size(); i += 2) {
+    int category = d.findCategory(modelRow[i]);
+    if (category < 0) {
+      error << "Error in row " << row << " of " << filename
+            << ". Category at position " << (i + 1)
+            << " is not part of options file.";
+      return error.str(); // Category not found in options
     }
 
-    std::unordered_set<std::string> uniqueCategoriesInRow;
+    int element = d.findElement(category, modelRow[i + 1]);
+    if (element < 0) {
+      error << "Error in row " << row << " of " << filename
+            << ". Element at position " << (i + 2)
+            << " is not part of category " << modelRow[i] << ".";
+      return error.str(); // Element not found in the specified category
+    }
 
-    for (size_t i = 0; i < modelRow.size(); i += 2) {
-      std::string category = modelRow[i];
-      std::string element = modelRow[i + 1];
+    if (ids[category] != -1) {
+      error << "Error in row " << row << " of " << filename
+            << ". Category at position " << (i + 1)
+            << " is a duplicate of another category in this row.";
+      return error.str(); // Duplicate category found in the current row
+    }
+    ids[category] = element;
+  }
 
-      // Check if the category exists in options
-      if (categoryToElements.find(category) == categoryToElements.end()) {
-        std::cerr << "Error in row " << row << " of " << filename
-                  << ". Category at position " << (i + 1)
-                  << " is not part of options file." << std::endl;
-        return 40; // Category not found in options
-      }
+  return std::string();
+}
 
-      // Check if the element is present in the specified category
-      if (std::find(categoryToElements[category].begin(),
-                    categoryToElements[category].end(),
-                    element) == categoryToElements[category].end()) {
-        std::cerr << "Error in row " << row << " of " << filename
-                  << ". Element at position " << (i + 2)
-                  << " is not part of category " << category << "."
-                  << std::endl;
-        return 40; // Element not found in the specified category
-      }
+template <typename Row>
+std::string CHECKER::checkRow(const DICTIONARY &d, const Row &modelRow,
+                              std::size_t row, const std::string &filename,
+                              std::vector<int> &ids) {
+  std::string error = checkFormat(d, modelRow, row, filename, ids);
+  if (!error.empty()) {
+    return error;
+  }
+  return checkIds(d, ids, row, filename);
+}
 
-      // Check if the category is unique in the current row
-      if (uniqueCategoriesInRow.find(category) == uniqueCategoriesInRow.end()) {
-        uniqueCategoriesInRow.insert(category);
-      } else {
-        std::cerr << "Error in row " << row << " of " << filename
-                  << ". Category at position " << (i + 1)
-                  << " is a duplicate of another category in this row."
-                  << std::endl;
-        return 40; // Duplicate category found in the current row
-      }
+std::string CHECKER::checkIds(const DICTIONARY &d, const std::vector<int> &ids,
+                              std::size_t row, const std::string &filename) {
+  // Check constraints
+  int id = findViolatedConstraint(d, ids);
+  if (id >= 0) {
+    std::ostringstream error;
+    error << "Error in row " << row << " of " << filename;
+    if (id < (int)d.getConstraints().size()) {
+      error << ". Row contains match for a combination from the "
+               "constraints file.";
+    } else {
+      error << ". Row violates an expression from the constraints file.";
     }
+    return error.str();
   }
 
-  return 0;
+  return std::string();
 }
 
-int CHECKER::checkConstraints(MODEL *m, PROBLEM *p) {
-  std::vector<std::vector<std::string>> constraints = p->getConstraints();
-  std::vector<std::vector<std::string>> models = m->getModels();
-  // Get filename from model
-  std::string filename = m->getModelsFile();
+int CHECKER::reportCoverage(const DICTIONARY &d, COVERAGE &coverage,
+                            const std::string &filename,
+                            const std::vector<std::size_t> *infeasible) {
+  int strength = coverage.getStrength();
+
+  // Combinations that are excluded by the constraints do not need to be
+  // covered
+  std::vector<std::size_t> found;
+  if (!infeasible) {
+    int status = findInfeasibleCombinations(d, strength, found);
+    if (status) {
+      return status;
+    }
+    infeasible = &found;
+  }
+  for (std::size_t index : *infeasible) {
+    coverage.set(index);
+  }
+
+  // Report every combination that is not covered
+  int result = 0;
+  std::vector<int> categories;
+  std::vector<int> elements;
+  for (std::size_t index = 0; index < coverage.getCount(); index++) {
+    if (coverage.isCovered(index)) {
+      continue;
+    }
+    coverage.decode(index, categories, elements);
+    std::cerr << "Error in " << filename << ". "
+              << (strength == 2 ? "Pair " : "Combination ");
+    for (int i = 0; i < strength; i++) {
+      std::cerr << (i ? ", " : "") << d.getCategoryName(categories[i]) << " "
+                << d.getElementName(categories[i], elements[i]);
+    }
+    std::cerr << " is not covered by any row." << std::endl;
+    result = 40;
+  }
 
-  for (const std::vector<std::string> &constraintRow : constraints) {
-    std::unordered_set<std::string> constraintSet(constraintRow.begin(),
-                                                  constraintRow.end());
+  return result;
+}
 
-    int row = 0;
-    for (const std::vector<std::string> &modelRow : models) {
-      row++;
-      std::unordered_set<std::string> modelSet(modelRow.begin(),
-                                               modelRow.end());
+int CHECKER::checkRows(
+    std::size_t count,
+    const std::function<std::string(unsigned, std::size_t)> &checkRow) {
+  // Row of the first error found so far, used to stop early in fail fast mode
+  std::atomic<std::size_t> firstError(count);
+  // Errors of each chunk, chunks are contiguous so their errors are in order
+  std::vector<std::vector<std::string>> errors(PARALLEL::getThreads());
 
-      bool containsAll = true;
-      for (const std::string &str : constraintSet) {
-        if (modelSet.find(str) == modelSet.end()) {
-          containsAll = false;
-          break;
-        }
-      }
+  PARALLEL::run(count, 1024,
+                [&](unsigned chunk, std::size_t begin, std::size_t end) {
+                  for (std::size_t i = begin; i < end; i++) {
+                    // An earlier row already failed, no need to continue
+                    if (failFast && i > firstError.load()) {
+                      return;
+                    }
+                    std::string error = checkRow(chunk, i);
+                    if (error.empty()) {
+                      continue;
+                    }
+                    errors[chunk].push_back(error);
+                    if (failFast) {
+                      std::size_t current = firstError.load();
+                      while (i < current &&
+                             !firstError.compare_exchange_weak(current, i)) {
+                      }
+                      return;
+                    }
+                  }
+                });
 
-      if (containsAll) {
-        std::cerr << "Error in row " << row << " of " << filename
-                  << ". Row contains match for a combination from the "
-                     "constraints file."
-                  << std::endl;
-        return 40; // Found a row in 'models' that contains a combination from a
-                   // row of 'constraints'
+  // Report errors in the order of the rows
+  for (const auto &chunk : errors) {
+    for (const auto &error : chunk) {
+      std::cerr << error << std::endl;
+      if (failFast) {
+        return 40;
       }
     }
   }
+  for (const auto &chunk : errors) {
+    if (!chunk.empty()) {
+      return 40;
+    }
+  }
   return 0;
 }
 
-int CHECKER::checkOptionsValid(MODEL *m, PROBLEM *p) {
-  // Get vectors from classes
-  std::vector<std::vector<std::string>> options = p->getOptions();
-  std::vector<std::vector<std::string>> models = m->getModels();
-  // Get filename from model
-  std::string filename = m->getModelsFile();
-
-  // Create a map to store the options for each category
-  std::unordered_map<std::string, std::vector<std::string>> categoryToElements;
+bool CHECKER::completeRow(const DICTIONARY &d, std::vector<int> &row) {
+  // Pick the unassigned category with the fewest allowed elements, so that
+  // contradictions between constraints are found as early as possible
+  int bestCategory = -1;
+  std::vector<int> bestElements;
+  for (int c = 0; c < d.getCategoryCount(); c++) {
+    if (row[c] != -1) {
+      continue;
+    }
 
-  // Populate the categoryToElements map with data from options
-  for (const auto &row : options) {
-    if (row.size() >= 2) {
-      std::string category = row[0];
-      for (size_t i = 1; i < row.size(); i++) {
-        categoryToElements[category].push_back(row[i]);
+    std::vector<int> allowed;
+    bool constrained = !d.getRulesWith(c).empty();
+    for (int e = 0; e < d.getElementCount(c); e++) {
+      if (!d.getConstraintsWith(c, e).empty()) {
+        constrained = true;
       }
+      if (!violatesConstraint(d, row, c, e)) {
+        allowed.push_back(e);
+      }
+    }
+
+    // Dead end, no element fits into this category
+    if (allowed.empty()) {
+      return false;
+    }
+    // Categories without constraints can take any element, so they are
+    // filled in at the end
+    if (!constrained) {
+      continue;
+    }
+    if (bestCategory == -1 || allowed.size() < bestElements.size()) {
+      bestCategory = c;
+      bestElements = allowed;
     }
   }
 
-  // Check if each row in models contains a category and element from options
-  int row = 0;
-  for (const auto &modelRow : models) {
-    row++;
-    // Each row in models must have an even number of elements (category,
-    // element, category, element, etc.)
-    if (modelRow.size() % 2 != 0) {
-      std::cerr << "Error in row " << row << " of " << filename
-                << ". Each category must be paired with an element."
-                << std::endl;
-      return 40;
+  // Only unconstrained categories are left
+  if (bestCategory == -1) {
+    for (int c = 0; c < d.getCategoryCount(); c++) {
+      if (row[c] == -1) {
+        row[c] = 0;
+      }
     }
+    return true;
+  }
 
-    for (size_t i = 0; i < modelRow.size(); i += 2) {
-      std::string category = modelRow[i];
-      std::string element = modelRow[i + 1];
+  // Try each allowed element and continue with the remaining categories
+  for (int e : bestElements) {
+    row[bestCategory] = e;
+    if (completeRow(d, row)) {
+      return true;
+    }
+  }
+  row[bestCategory] = -1;
+  return false;
+}
 
-      // Check if the category exists in options and if the element is present
-      // in that category
-      if (categoryToElements.find(category) == categoryToElements.end()) {
-        std::cerr << "Error in row " << row << " of " << filename
-                  << ". Category at position " << i
-                  << " is not part of options file." << std::endl;
-        return 40; // Category not found in options
+bool CHECKER::violatesConstraint(const DICTIONARY &d,
+                                 const std::vector<int> &row, int category,
+                                 int element) {
+  for (int id : d.getConstraintsWith(category, element)) {
+    bool matched = true;
+    for (const auto &entry : d.getConstraints()[id]) {
+      if (entry.first == category) {
+        matched = entry.second == element;
+      } else {
+        matched = row[entry.first] == entry.second;
       }
+      if (!matched) {
+        break;
+      }
+    }
+    if (matched) {
+      return true;
+    }
+  }
+  for (int id : d.getRulesWith(category)) {
+    if (d.getRules()[id].evaluate(row, category, element) ==
+        EXPRESSION::FALSE) {
+      return true;
+    }
+  }
+  return false;
+}
 
-      bool elementFound = false;
-      for (const auto &optionElement : categoryToElements[category]) {
-        if (element == optionElement) {
-          elementFound = true;
+int CHECKER::findViolatedConstraint(const DICTIONARY &d,
+                                    const std::vector<int> &ids) {
+  const auto &constraints = d.getConstraints();
+
+  // Each constraint is only listed under its first entry, so it is looked at
+  // once and only if the row contains that entry
+  for (std::size_t c = 0; c < ids.size(); c++) {
+    if (ids[c] < 0) {
+      continue;
+    }
+    for (int id : d.getConstraintsStartingWith(c, ids[c])) {
+      bool matched = true;
+      for (const auto &entry : constraints[id]) {
+        if (ids[entry.first] != entry.second) {
+          matched = false;
           break;
         }
       }
-
-      if (!elementFound) {
-        std::cerr << "Error in row " << row << " of " << filename
-                  << ". Element at position " << i
-                  << " is not part of options file." << std::endl;
-        return 40; // Element not found in the specified category
+      if (matched) {
+        return id;
       }
     }
   }
 
-  return 0;
+  // Expressions are numbered after the constraints
+  const auto &rules = d.getRules();
+  for (std::size_t i = 0; i < rules.size(); i++) {
+    if (rules[i].evaluate(ids) == EXPRESSION::FALSE) {
+      return constraints.size() + i;
+    }
+  }
+
+  return -1;
 }
@@ -11,10 +11,17 @@
 #ifndef PAIRWISE_CHECKER
 #define PAIRWISE_CHECKER
 
+#include "coverage.hpp"
+#include "dictionary.hpp"
+#include "report.hpp"
 #include "problem.hpp"
 #include "logger.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -27,6 +34,19 @@ class MODEL;
  *
  */
 class CHECKER {
+private:
+  /**
+   * @brief If true, checks stop at the first invalid row, otherwise every
+   * invalid row is reported
+   */
+  static bool failFast;
+
+  /**
+   * @brief Name of the file a coverage report is written to by checkStream(),
+   * empty if no report is written
+   */
+  static std::string reportFile;
+
 public:
   CHECKER();
   ~CHECKER();
@@ -38,9 +58,91 @@ public:
    * @param m reference to instance of model class containing model
    * @param p reference to instance of problem class containting options and
    * constraints
+   * @param strength number of categories per combination that has to be
+   * covered, default = 2 (pairwise)
    * @return int status code (see documentation)
    */
-  static int check(MODEL *m, PROBLEM *p);
+  static int check(MODEL *m, PROBLEM *p, int strength = 2);
+
+  /**
+   * @brief Checks a model while reading it from its .models file
+   * @note The rows are not stored in the model, memory use is constant apart
+   * from the coverage bitmap. Rows are checked in order on a single thread,
+   * the error messages are the same as for check().
+   *
+   * @param m reference to instance of model class containing the filename of
+   * the .models file, "-" for stdin
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @param strength number of categories per combination that has to be
+   * covered, default = 2 (pairwise)
+   * @return int status code (see documentation), 10 if the .models file can
+   * not be opened
+   */
+  static int checkStream(MODEL *m, PROBLEM *p, int strength = 2);
+
+  /**
+   * @brief Checks rows one at a time as they are handed over, e.g. while
+   * they are generated by the solver
+   * @note Like checkStream() the rows are not stored, only the coverage
+   * bitmap is kept. The input files are not checked again. Every row is
+   * requested even after an invalid row, so that the caller can hand on all
+   * rows.
+   *
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @param strength number of categories per combination that has to be
+   * covered
+   * @param filename Filename used for error messages
+   * @param next function returning the next row, nullptr after the last row.
+   * The row must stay valid until next is called again.
+   * @return int status code (see documentation)
+   */
+  static int
+  checkSequence(PROBLEM *p, int strength, const std::string &filename,
+                const std::function<const std::vector<std::string> *()> &next);
+
+  /**
+   * @brief Checks a model like checkStream(), but only the rows appended
+   * since the last run
+   * @note The state after the last complete row is stored in a checkpoint
+   * file next to the .models file (filename + ".checkpoint"). If the options,
+   * constraints or strength changed, or the checked part of the file was
+   * modified, the complete file is checked again. No checkpoint is written
+   * if a row is invalid.
+   *
+   * @param m reference to instance of model class containing the filename of
+   * the .models file
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @param strength number of categories per combination that has to be
+   * covered, default = 2 (pairwise)
+   * @return int status code (see documentation), 10 if the .models file can
+   * not be opened
+   */
+  static int checkIncremental(MODEL *m, PROBLEM *p, int strength = 2);
+
+  /**
+   * @brief Compares the coverage of two models for the same problem
+   * @note Both .models files are streamed at the same time on separate
+   * threads, each into its own bitmap. Prints the number of rows of each
+   * file, the distinct rows contained in both in the order of their
+   * elements, and every combination only one of the files covers. Rows are
+   * compared by their elements, so the order of the categories within a row
+   * does not matter.
+   *
+   * @param before reference to instance of model class containing the
+   * filename of the old .models file
+   * @param after reference to instance of model class containing the
+   * filename of the new .models file
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @param strength number of categories per combination, default = 2
+   * (pairwise)
+   * @return int status code (see documentation), 10 if a .models file can
+   * not be opened
+   */
+  static int diff(MODEL *before, MODEL *after, PROBLEM *p, int strength = 2);
 
   /**
    * @brief Allows access to the internal checkInputFiles() function
@@ -55,11 +157,63 @@ public:
    */
   static int checkFiles(PROBLEM *p);
 
+  /**
+   * @brief Set the fail fast mode
+   * @note Rows are checked on several threads (see PARALLEL), errors are
+   * always reported in the order of the rows
+   *
+   * @param enabled if true (default), checks stop at the first invalid row,
+   * otherwise every invalid row is reported
+   */
+  static void setFailFast(bool enabled);
+
+  /**
+   * @brief Set the file a JSON coverage report is written to
+   * @note The report is only written by checkStream(), since the number of
+   * combinations each row adds depends on the order of the rows. It is
+   * written once all rows passed (see REPORT).
+   *
+   * @param filename name of the report file, "-" for stdout, empty to
+   * disable the report (default)
+   */
+  static void setReportFile(const std::string &filename);
+
+  /**
+   * @brief Finds all pairs of elements that can not be part of any row that
+   * complies with the constraints
+   * @note This includes pairs that are only excluded indirectly through
+   * several constraints. Should only be run once checkFiles() has passed.
+   *
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @param infeasible reference to vector the infeasible pairs are written to,
+   * in the same order as generated by the solver
+   * @return int status code (see documentation)
+   */
+  static int findInfeasiblePairs(
+      PROBLEM *p,
+      std::vector<std::tuple<std::string, std::string, std::string,
+                             std::string>> &infeasible);
+
+  /**
+   * @brief Finds all combinations of elements from t different categories
+   * that can not be part of any row that complies with the constraints
+   *
+   * @param d dictionary containing the compiled problem
+   * @param strength number of categories per combination
+   * @param infeasible reference to vector the indices (see COVERAGE) of the
+   * infeasible combinations are written to
+   * @return int status code (see documentation)
+   */
+  static int findInfeasibleCombinations(const DICTIONARY &d, int strength,
+                                        std::vector<std::size_t> &infeasible);
+
   // Friends
   friend bool testInputFiles();
   friend bool testOptionsCoverage();
   friend bool testConstraints();
   friend bool testOptionsValid();
+  friend bool testCoverage();
 
 private:
   /**
@@ -73,6 +227,8 @@ private:
 
   /**
    * @brief check if each Mdoel contains all options
+   * @note Runs the format checks of checkModels() without the constraints,
+   * see checkFormat()
    *
    * @param p reference to instance of problem class containting options and
    * constraints
@@ -83,6 +239,9 @@ private:
 
   /**
    * @brief check if each Mdoel contains only valid categories and options
+   * @note Runs the same checks as checkOptionCoverage(), so rows missing a
+   * category or naming one twice are rejected as well. Positions in the
+   * error messages count the fields of the row from 1.
    *
    * @param m reference to instance of model class containing model
    * @param p reference to instance of problem class containting options and
@@ -93,6 +252,7 @@ private:
 
   /**
    * @brief checks if all Models obeys the constraints
+   * @note Rows with an invalid format are left to checkOptionCoverage()
    *
    * @param p reference to instance of problem class containting options and
    * constraints
@@ -100,6 +260,190 @@ private:
    * @return int status code (see documentation)
    */
   static int checkConstraints(MODEL *m, PROBLEM *p);
+
+  /**
+   * @brief checks if every combination of t elements that is allowed by the
+   * constraints is covered by at least one model
+   * @note Only rows passing checkModels() count, errors are not printed
+   *
+   * @param m reference to instance of model class containing model
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @param strength number of categories per combination (2 for pairs)
+   * @return int status code (see documentation)
+   */
+  static int checkCoverage(MODEL *m, PROBLEM *p, int strength);
+
+  /**
+   * @brief runs all checks of the models in a single pass over the rows
+   * @note Uses one lookup table for all checks, each row is translated to ids
+   * once and then checked for its format, the constraints and the
+   * combinations it covers
+   *
+   * @param m reference to instance of model class containing model
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @param strength number of categories per combination (2 for pairs)
+   * @return int status code (see documentation)
+   */
+  static int checkModels(MODEL *m, PROBLEM *p, int strength);
+
+  /**
+   * @brief runs all checks on a table of rows, see checkModels()
+   *
+   * @tparam Rows std::vector<std::vector<std::string>> or TABLE
+   * @param models rows of the model
+   * @param filename name of the models file, used for error messages
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @param strength number of categories per combination (2 for pairs)
+   * @return int status code (see documentation)
+   */
+  template <typename Rows>
+  static int checkTable(const Rows &models, const std::string &filename,
+                        PROBLEM *p, int strength);
+
+  /**
+   * @brief reads rows from a .models file and runs all checks on them
+   * @note Rows that pass are added to the bitmap, errors are printed
+   * immediately
+   *
+   * @param d dictionary containing the compiled problem
+   * @param coverage bitmap the covered combinations are added to
+   * @param filename name of the models file
+   * @param offset byte offset to start reading at, receives the offset behind
+   * the last complete row
+   * @param rows number of rows before offset, used for error messages,
+   * receives the number of rows read in total
+   * @param report if not null, records the combinations each row adds
+   * @return int status code (see documentation), 10 if the file can not be
+   * opened
+   */
+  static int streamModels(const DICTIONARY &d, COVERAGE &coverage,
+                          const std::string &filename, std::size_t &offset,
+                          std::size_t &rows, REPORT *report = nullptr);
+
+  /**
+   * @brief checks the format of a single model row and translates it to ids
+   * @note Checks that each category is paired with an element, that every
+   * category of the options appears exactly once and that each element
+   * belongs to its category. Constraints are checked by checkIds().
+   *
+   * @param d dictionary containing the compiled problem
+   * @param modelRow row of alternating category and element names
+   * @param row number of the row, used for error messages
+   * @param filename name of the models file, used for error messages
+   * @param ids vector the element ids are written to, indexed by category id
+   * @tparam Row std::vector<std::string> or FIELDS
+   * @return std::string error message, empty if the row is valid
+   */
+  template <typename Row>
+  static std::string checkFormat(const DICTIONARY &d, const Row &modelRow,
+                                 std::size_t row, const std::string &filename,
+                                 std::vector<int> &ids);
+
+  /**
+   * @brief checks a single model row and translates it to ids, runs
+   * checkFormat() and then checkIds()
+   *
+   * @param d dictionary containing the compiled problem
+   * @param modelRow row of alternating category and element names
+   * @param row number of the row, used for error messages
+   * @param filename name of the models file, used for error messages
+   * @param ids vector the element ids are written to, indexed by category id
+   * @tparam Row std::vector<std::string> or FIELDS
+   * @return std::string error message, empty if the row is valid
+   */
+  template <typename Row>
+  static std::string checkRow(const DICTIONARY &d, const Row &modelRow,
+                              std::size_t row, const std::string &filename,
+                              std::vector<int> &ids);
+
+  /**
+   * @brief checks a model row that was already translated to ids, see
+   * checkRow()
+   *
+   * @param d dictionary containing the compiled problem
+   * @param ids element ids of the row, indexed by category id
+   * @param row number of the row, used for error messages
+   * @param filename name of the models file, used for error messages
+   * @return std::string error message, empty if the row is valid
+   */
+  static std::string checkIds(const DICTIONARY &d, const std::vector<int> &ids,
+                              std::size_t row, const std::string &filename);
+
+  /**
+   * @brief reports every combination that is neither covered nor excluded by
+   * the constraints
+   *
+   * @param d dictionary containing the compiled problem
+   * @param coverage bitmap of the covered combinations, infeasible
+   * combinations are marked as well
+   * @param filename name of the models file, used for error messages
+   * @param infeasible indices of the infeasible combinations if they are
+   * already known, otherwise they are searched
+   * @return int status code (see documentation)
+   */
+  static int
+  reportCoverage(const DICTIONARY &d, COVERAGE &coverage,
+                 const std::string &filename,
+                 const std::vector<std::size_t> *infeasible = nullptr);
+
+  /**
+   * @brief Runs a check on every model row, rows are split into chunks that
+   * are checked on several threads
+   * @note Errors are printed in the order of the rows, so the output does not
+   * depend on the number of threads
+   *
+   * @param count number of rows
+   * @param checkRow function checking the row with the given index, returns
+   * the error message or an empty string if the row is valid. Also receives
+   * the number of the chunk (< PARALLEL::getThreads()) the row belongs to.
+   * @return int status code (see documentation)
+   */
+  static int checkRows(
+      std::size_t count,
+      const std::function<std::string(unsigned, std::size_t)> &checkRow);
+
+  /**
+   * @brief Tries to assign an element to every unassigned category of a row
+   * without violating any constraint
+   *
+   * @param d dictionary containing the compiled problem
+   * @param row partial row of element ids, unassigned categories are -1
+   * @return true if a valid row was found, row contains the complete row
+   * @return false if no valid row exists
+   */
+  static bool completeRow(const DICTIONARY &d, std::vector<int> &row);
+
+  /**
+   * @brief Checks if assigning an element to a category completes the match
+   * of any constraint
+   *
+   * @param d dictionary containing the compiled problem
+   * @param row partial row of element ids, unassigned categories are -1
+   * @param category id of the category to be assigned
+   * @param element id of the element to be assigned
+   * @return true if the assignment violates a constraint
+   * @return false if the assignment is allowed
+   */
+  static bool violatesConstraint(const DICTIONARY &d,
+                                 const std::vector<int> &row, int category,
+                                 int element);
+
+  /**
+   * @brief Finds a constraint that is completely matched by a row
+   * @note Uses the index of the dictionary, so only constraints whose first
+   * entry is part of the row are compared with the row
+   *
+   * @param d dictionary containing the compiled problem
+   * @param ids element ids of the row indexed by category id, -1 for
+   * categories that are not part of the row
+   * @return int id of a matched constraint, -1 if there is none. Expressions
+   * that the row violates are reported with ids following the constraints.
+   */
+  static int findViolatedConstraint(const DICTIONARY &d,
+                                    const std::vector<int> &ids);
 };
 
 #endif
\ No newline at end of file
@@ -9,35 +9,120 @@
  *
  */
 
+#include "checker.hpp"
 #include "model.hpp"
+#include "parallel.hpp"
 #include "problem.hpp"
 #include "logger.hpp"
+#include <climits>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
 
 /**
  * @brief Main function for checkerMain program
  *
  * @param argc argument count
  * @param argv argument values
+ * @arg \c --strength (optional) followed by the number of categories per
+ * combination that has to be covered, from 2 up to the number of categories
+ * in the options, default = 2 (pairwise)
+ * @arg \c --threads (optional) followed by the number of threads used for
+ * parsing and checking, a positive number, default = one per core
+ * @arg \c --all-errors (optional) report every invalid row instead of
+ * stopping at the first one
+ * @arg \c --stream (optional) check the rows while reading the models file
+ * instead of loading it completely, "-" as modelsFile reads from stdin
+ * @arg \c --incremental (optional) like --stream, but only the rows appended
+ * since the last run are checked (see CHECKER::checkIncremental())
+ * @arg \c --report (optional) followed by the name of a file a JSON coverage
+ * report is written to, "-" for stdout. Implies --stream, the report needs
+ * all rows in order.
+ * @arg \c --diff (optional) followed by the filename of an older .models
+ * file, prints the combinations only one of the two files covers instead of
+ * a full check (see CHECKER::diff())
+ * @arg \c --log (optional) followed by the lowest level of log messages
+ * printed, "trace", "debug", "info", "warning" or "off" (see LOGGER)
  * @arg \c optionsFile Filename for .options file
  * @arg \c constraintsFile Filename for .constraints file
  * @arg \c modelsFile Filename for .models file
  * @return \c int status code (see documentation)
  */
 int main(int argc, char **argv) {
-  //Set this to true to enable verbose logging to console
-  LOGGER::SetVerboseMode(false);
+  // Only warnings are printed unless PAIRWISE_LOG or --log name a level
+  LOGGER::configure();
+
+  // Separate optional flags from filenames
+  int strength = 2;
+  bool stream = false;
+  bool incremental = false;
+  std::string report;
+  std::string diff;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    if (argument == "--strength" && i + 1 < argc) {
+      // The upper limit depends on the options, see below
+      char *end = nullptr;
+      long value = std::strtol(argv[++i], &end, 10);
+      if (end == argv[i] || *end != '\0' || value < 2 || value > INT_MAX) {
+        std::cout << "Invalid strength: " << argv[i]
+                  << ", expected a number of at least 2" << std::endl;
+        return 10;
+      }
+      strength = value;
+    } else if (argument == "--threads" && i + 1 < argc) {
+      // Only positive numbers, garbage must not silently mean one per core
+      char *end = nullptr;
+      long threads = std::strtol(argv[++i], &end, 10);
+      if (end == argv[i] || *end != '\0' || threads < 1 ||
+          threads > INT_MAX) {
+        std::cout << "Invalid number of threads: " << argv[i] << std::endl;
+        return 10;
+      }
+      PARALLEL::setThreads(threads);
+    } else if (argument == "--all-errors") {
+      CHECKER::setFailFast(false);
+    } else if (argument == "--stream") {
+      stream = true;
+    } else if (argument == "--incremental") {
+      incremental = true;
+    } else if (argument == "--report" && i + 1 < argc) {
+      report = argv[++i];
+    } else if (argument == "--diff" && i + 1 < argc) {
+      diff = argv[++i];
+    } else if (argument == "--log" && i + 1 < argc) {
+      if (!LOGGER::setLevel(argv[++i])) {
+        std::cout << "Unknown log level: " << argv[i] << std::endl;
+        return 20;
+      }
+    } else {
+      files.push_back(argument);
+    }
+  }
+
+  // The report is written by the streaming check, which needs every row
+  if (!report.empty() && incremental) {
+    std::cout << "--report can not be combined with --incremental"
+              << std::endl;
+    return 10;
+  }
+  if (!report.empty()) {
+    CHECKER::setReportFile(report);
+    stream = true;
+  }
 
   // Check if correct number of arguments were supplied
-  if (argc != 4) {
+  if (files.size() != 3) {
     std::cout << "Invalid number of arguments supplied" << std::endl;
     return 10;
   }
 
   // Create instance of problem and model class using given file locations /
   // arguments
-  PROBLEM problem = PROBLEM(argv[1], argv[2]);
-  MODEL model = MODEL(&problem, argv[3]);
+  PROBLEM problem = PROBLEM(files[0], files[1]);
+  MODEL model = MODEL(&problem, files[2]);
 
   // Parse problem
   int parseProblem = problem.parse();
@@ -45,14 +130,39 @@ int main(int argc, char **argv) {
     return parseProblem;
   }
 
-  // Parse model
-  int parseModel = model.parse();
-  if (parseModel) {
-    return 40;
+  // A combination can not contain more categories than the options define
+  std::size_t categories = problem.getOptions().size();
+  if (static_cast<std::size_t>(strength) > categories) {
+    std::cout << "Invalid strength: " << strength << ", the options define "
+              << categories << " categories" << std::endl;
+    return 10;
   }
 
-  // Check model
-  int checkModel = model.check();
+  int checkModel = 0;
+  if (!diff.empty()) {
+    // Compare coverage of both models
+    MODEL before = MODEL(&problem, diff);
+    checkModel = CHECKER::diff(&before, &model, &problem, strength);
+    if (checkModel == 10) {
+      return 40;
+    }
+  } else if (stream || incremental) {
+    // Parse and check model row by row
+    checkModel = incremental ? model.checkIncremental(strength)
+                             : model.checkStream(strength);
+    if (checkModel == 10) {
+      return 40;
+    }
+  } else {
+    // Parse model, the file is mapped into memory instead of copying rows
+    int parseModel = model.map();
+    if (parseModel) {
+      return 40;
+    }
+
+    // Check model
+    checkModel = model.check(strength);
+  }
   // Translate return codes
   if (checkModel == 20) {
     return 10;
@@ -63,19 +173,22 @@ int main(int argc, char **argv) {
   if (checkModel == 40) {
     return 30;
   }
+  // stdout only contains the report in this case
+  std::ostream &verdict = report == "-" ? std::cerr : std::cout;
+
   // If the only issue is that the options file contains useless elements
   // that is still a pass
   if (checkModel == 100) {
-    std::cout << "\033[1;32mVERIFIED\033[0m\n";
+    verdict << "\033[1;32mVERIFIED\033[0m\n";
     return 0;
   }
   // If there are other issues, fail the model
   else if (checkModel) {
-    std::cout << "\033[1;31mUNVERIFIED\033[0m\n";
+    verdict << "\033[1;31mUNVERIFIED\033[0m\n";
     return checkModel;
   }
 
-  std::cout << "\033[1;32mVERIFIED\033[0m\n";
+  verdict << "\033[1;32mVERIFIED\033[0m\n";
 
   return 0;
 }
\ No newline at end of file
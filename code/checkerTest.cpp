@@ -10,7 +10,17 @@
  */
 
 #include "checker.hpp"
+#include "checkpoint.hpp"
+#include "memory.hpp"
 #include "model.hpp"
+#include "parallel.hpp"
+#include "prettyPrint.hpp"
+#include "writer.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 
 ///////////////////////////////////////////////////////////////////////////////
 // Helper Functions                                                         //
@@ -330,6 +340,21 @@ bool testConstraints() {
       {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
        "ElementX"}};
   
+  // CategoryC contains an element with the same name as an element of
+  // CategoryB, this must not be mistaken for a match of constraints1
+  std::vector<std::vector<std::string>> optionsCollision = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementA", "ElementX"}};
+
+  std::vector<std::vector<std::string>> constraintsCollision = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA"},
+  };
+
+  std::vector<std::vector<std::string>> modelCollision = {
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementA"}};
+
   std::vector<std::vector<std::string>> model2InvalidJumbled = {
       {"CategoryB", "ElementB", "CategoryA", "Element2", "CategoryC",
        "ElementZ"},
@@ -403,6 +428,81 @@ bool testConstraints() {
   }
   std::cout << "\033[1;32mPASSED\033[0m\n";
 
+  // Test with element names shared between categories
+  p->setOptions(optionsCollision);
+  p->setConstraints(constraintsCollision);
+  m->setModel(modelCollision);
+  std::cout << "Test with element name shared between categories: "
+            << std::endl;
+  result = CHECKER::checkConstraints(m, p);
+  if (result != 0) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Expressions are split at their commas by the parser
+  std::vector<std::vector<std::string>> constraintsExpression = {
+      {"@ CategoryA=Element1 => CategoryB in (ElementB", " ElementC)"},
+      {"CategoryB", "ElementC", "CategoryC", "ElementX"}};
+
+  std::vector<std::vector<std::string>> constraintsInvalidExpression = {
+      {"@ CategoryA=Element1 and not (CategoryC!=ElementW)"}};
+
+  // Test with an expression that every row fulfills
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsExpression);
+  m->setModel(model2ValidJumbled);
+  std::cout << "Test with model fulfilling an expression: " << std::endl;
+  result = CHECKER::checkConstraints(m, p);
+  if (result != 0) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test with a row violating the expression
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsExpression);
+  m->setModel(model1Valid);
+  std::cout << "Test with model violating an expression: " << std::endl;
+  result = CHECKER::checkConstraints(m, p);
+  if (result != 40) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test that pairs excluded by an expression are found
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsExpression);
+  std::vector<std::tuple<std::string, std::string, std::string, std::string>>
+      infeasible;
+  std::cout << "Test with pairs excluded by an expression: " << std::endl;
+  result = CHECKER::findInfeasiblePairs(p, infeasible);
+  // The second constraint excludes the pair CategoryB ElementC, CategoryC
+  // ElementX as well
+  if (result != 0 || infeasible.size() != 2 ||
+      infeasible[0] != std::make_tuple(std::string("CategoryA"),
+                                       std::string("Element1"),
+                                       std::string("CategoryB"),
+                                       std::string("ElementA"))) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test with an expression naming an unknown element
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsInvalidExpression);
+  std::cout << "Test with invalid expression: " << std::endl;
+  result = CHECKER::checkFiles(p);
+  if (result != 30) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
   return true;
 }
 
@@ -510,60 +610,1289 @@ bool testOptionsValid() {
   }
   std::cout << "\033[1;32mPASSED\033[0m\n";
 
+  // Test that the same errors are printed as by the combined check, without
+  // constraints the combined check only fails on the format of the rows
+  p->setOptions(optionsValid);
+  p->setConstraints({});
+  std::cout << "Testing same errors as checkModels(): " << std::endl;
+  for (const auto &model :
+       {modelMissingElement, modelInvalidElement, modelInvalidCategory}) {
+    m->setModel(model);
+    std::ostringstream single;
+    std::ostringstream combined;
+    std::streambuf *console = std::cerr.rdbuf(single.rdbuf());
+    result = CHECKER::checkOptionsValid(m, p);
+    std::cerr.rdbuf(combined.rdbuf());
+    int combinedResult = CHECKER::checkModels(m, p, 2);
+    std::cerr.rdbuf(console);
+    if (result != 40 || combinedResult != 40 || single.str().empty() ||
+        single.str() != combined.str()) {
+      std::cout << "\033[1;31mFAILED\033[0m\n";
+      return false;
+    }
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
   return true;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-// Main Function                                                            //
-/////////////////////////////////////////////////////////////////////////////
 /**
- * @brief runs all tests for CHECKER
+ * @brief tests CHECKER::findInfeasiblePairs() function
  *
- * @return int status code (see documentation)
+ * @return true if tests pass
+ * @return false if tests fail
  */
-int main() {
-  //Set this to true to enable verbose logging to console
-  LOGGER::SetVerboseMode(false);
-  
-  int counter = 0;
-  bool input = 0;
-  std::cout << "Checker Test" << std::endl;
-  std::cout << "-------------------------------------" << std::endl;
-  std::cout << "-------------------------------------" << std::endl;
+bool testInfeasiblePairs() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test; // Pointer to sample problem
+  int result;         // Temporarily stores result
+  std::vector<std::tuple<std::string, std::string, std::string, std::string>>
+      infeasible; // Temporarily stores infeasible pairs
 
-  std::cout << "Starting test of checkInputFiles()" << std::endl;
-  input = testInputFiles();
-  if (input) {
-    counter++;
+  std::vector<std::vector<std::string>> optionsValid = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB", "ElementC"},
+      {"CategoryC", "ElementX", "ElementY", "ElementZ"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> constraintsDirect = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA"},
+      {"CategoryA", "Element1", "CategoryC", "ElementX", "CategoryB",
+       "ElementB"}};
+
+  std::vector<std::tuple<std::string, std::string, std::string, std::string>>
+      expectedDirect = {
+          std::make_tuple("CategoryA", "Element1", "CategoryB", "ElementA")};
+
+  // ElementZ can not be combined with any element of CategoryB, so every pair
+  // containing it is excluded indirectly
+  std::vector<std::vector<std::string>> constraintsIndirect = {
+      {"CategoryC", "ElementZ", "CategoryB", "ElementA"},
+      {"CategoryC", "ElementZ", "CategoryB", "ElementB"},
+      {"CategoryC", "ElementZ", "CategoryB", "ElementC"}};
+
+  std::vector<std::tuple<std::string, std::string, std::string, std::string>>
+      expectedIndirect = {
+          std::make_tuple("CategoryA", "Element1", "CategoryC", "ElementZ"),
+          std::make_tuple("CategoryA", "Element2", "CategoryC", "ElementZ"),
+          std::make_tuple("CategoryB", "ElementA", "CategoryC", "ElementZ"),
+          std::make_tuple("CategoryB", "ElementB", "CategoryC", "ElementZ"),
+          std::make_tuple("CategoryB", "ElementC", "CategoryC", "ElementZ")};
+
+  // Test without constraints
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsNone);
+  infeasible.clear();
+  std::cout << "Testing without constraints: " << std::endl;
+  result = CHECKER::findInfeasiblePairs(p, infeasible);
+  if (result != 0 || !infeasible.empty()) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
   }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
 
-  std::cout << "-------------------------------------" << std::endl;
+  // Test with directly excluded pair
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsDirect);
+  infeasible.clear();
+  std::cout << "Testing with directly excluded pair: " << std::endl;
+  result = CHECKER::findInfeasiblePairs(p, infeasible);
+  if (result != 0 || infeasible != expectedDirect) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
 
-  std::cout << "Starting test of checkOptionsCoverage()" << std::endl;
-  input = testOptionsCoverage();
-  if (input) {
-    counter++;
+  // Test with indirectly excluded pairs
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsIndirect);
+  infeasible.clear();
+  std::cout << "Testing with indirectly excluded pairs: " << std::endl;
+  result = CHECKER::findInfeasiblePairs(p, infeasible);
+  if (result != 0 || infeasible != expectedIndirect) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
   }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
 
-  std::cout << "-------------------------------------" << std::endl;
+  return true;
+}
 
-  std::cout << "Starting test of checkConstraints()" << std::endl;
-  input = testConstraints();
-  if (input) {
-    counter++;
+/**
+ * @brief tests CHECKER::checkCoverage() function
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testCoverage() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> constraintsMissingPair = {
+      {"CategoryA", "Element2", "CategoryB", "ElementB"}};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Pair Element2, ElementB is missing
+  std::vector<std::vector<std::string>> modelMissingPair = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementY"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementX"},
+      {"CategoryC", "ElementY", "CategoryA", "Element2", "CategoryB",
+       "ElementA"}};
+
+  // Test with complete model
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  std::cout << "Testing with model covering all pairs: " << std::endl;
+  result = CHECKER::checkCoverage(m, p, 2);
+  if (result != 0) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
   }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
 
-  std::cout << "-------------------------------------" << std::endl;
+  // Test with missing pair
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelMissingPair);
+  std::cout << "Testing with model missing a pair: " << std::endl;
+  result = CHECKER::checkCoverage(m, p, 2);
+  if (result != 40) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
 
-  std::cout << "Starting test of checkOptionsValid()" << std::endl;
-  input = testOptionsValid();
+  // Test with missing pair that is excluded by the constraints
+  p->setOptions(options);
+  p->setConstraints(constraintsMissingPair);
+  m->setModel(modelMissingPair);
+  std::cout << "Testing with missing pair excluded by constraints: "
+            << std::endl;
+  result = CHECKER::checkCoverage(m, p, 2);
+  if (result != 0) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test with strength 3, four rows can not cover all eight combinations
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  std::cout << "Testing with strength 3: " << std::endl;
+  result = CHECKER::checkCoverage(m, p, 3);
+  if (result != 40) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests CHECKER::checkStream() function
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testStream() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Pair Element2, ElementB is missing
+  std::vector<std::vector<std::string>> modelMissingPair = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementY"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementX"},
+      {"CategoryC", "ElementY", "CategoryA", "Element2", "CategoryB",
+       "ElementA"}};
+
+  // Test streaming check, rows are read back from the models file
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  m->print();
+  std::cout << "Testing streaming check with complete model: " << std::endl;
+  result = CHECKER::checkStream(m, p, 2);
+  if (result != 0) {
+    std::remove("test.models");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test streaming check with a model missing a pair
+  m->setModel(modelMissingPair);
+  m->print();
+  std::cout << "Testing streaming check with model missing a pair: "
+            << std::endl;
+  result = CHECKER::checkStream(m, p, 2);
+  std::remove("test.models");
+  if (result != 40) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests checking models files mapped into memory (see MODEL::map())
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testMappedModels() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Test check of a mapped models file, rows are not copied to the model
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  m->print();
+  MODEL mappedModel = MODEL(p, "test.models");
+  std::cout << "Testing check with mapped model: " << std::endl;
+  result = mappedModel.map();
+  if (result == 0) {
+    result = CHECKER::check(&mappedModel, p, 2);
+  }
+  if (result != 0 || mappedModel.getTable()->size() != modelComplete.size()) {
+    std::remove("test.models");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test models file with CRLF line breaks, both parsers have to drop the
+  // carriage returns
+  std::ofstream crlf("test.models", std::ios::binary);
+  for (const auto &row : modelComplete) {
+    for (std::size_t i = 0; i < row.size(); i++) {
+      crlf << (i ? "," : "") << row[i];
+    }
+    crlf << "\r\n";
+  }
+  crlf.close();
+  MODEL crlfModel = MODEL(p, "test.models");
+  std::cout << "Testing models file with CRLF line breaks: " << std::endl;
+  result = crlfModel.map();
+  if (result == 0) {
+    result = CHECKER::check(&crlfModel, p, 2);
+  }
+  if (result == 0) {
+    result = CHECKER::checkStream(&crlfModel, p, 2);
+  }
+  std::remove("test.models");
+  if (result != 0) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test mapping a large models file on several threads, quoted fields with
+  // line breaks are longer than the rest of their row, so most boundaries
+  // between the ranges of the threads fall inside quotes
+  {
+    std::ofstream quoted("test.models");
+    std::string field = "\"Element";
+    for (int i = 0; i < 20; i++) {
+      field += "\n" + std::string(40, 'a' + i);
+    }
+    for (int i = 0; i < 3000; i++) {
+      quoted << "CategoryA," << field << i << "\",CategoryB,ElementA\n";
+    }
+  }
+  std::cout << "Testing large models file mapped on several threads: "
+            << std::endl;
+  PARALLEL::setThreads(1);
+  result = m->map();
+  std::vector<std::vector<std::string>> singleRows;
+  if (result == 0) {
+    singleRows = m->getTable()->toVector();
+  }
+  PARALLEL::setThreads(8);
+  if (result == 0) {
+    result = m->map();
+  }
+  PARALLEL::setThreads(0);
+  std::vector<std::vector<std::string>> severalRows;
+  if (result == 0) {
+    severalRows = m->getTable()->toVector();
+  }
+  std::remove("test.models");
+  if (result != 0 || singleRows.size() != 3000 ||
+      singleRows[1234].size() != 4 || singleRows != severalRows) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests the coverage report written by CHECKER::checkStream()
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testReport() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Pair Element2, ElementB is missing
+  std::vector<std::vector<std::string>> modelMissingPair = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementY"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementX"},
+      {"CategoryC", "ElementY", "CategoryA", "Element2", "CategoryB",
+       "ElementA"}};
+
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelMissingPair);
+  m->print();
+
+  // Test coverage report, the missing pair has to be listed
+  std::cout << "Testing coverage report: " << std::endl;
+  CHECKER::setReportFile("test.json");
+  result = CHECKER::checkStream(m, p, 2);
+  CHECKER::setReportFile("");
+  std::ifstream report("test.json");
+  std::string contents((std::istreambuf_iterator<char>(report)),
+                       std::istreambuf_iterator<char>());
+  report.close();
+  std::remove("test.json");
+  if (result != 40 ||
+      contents.find("\"uncovered\": [\n    [\"CategoryA\", \"Element2\", "
+                    "\"CategoryB\", \"ElementB\"]\n  ]") ==
+          std::string::npos ||
+      contents.find("\"rows\": 5,") == std::string::npos) {
+    std::remove("test.models");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test coverage report of a model with an invalid third row, the report
+  // covers the rows before it
+  MODEL invalidModel = MODEL(p, "test2.models");
+  std::vector<std::vector<std::string>> modelInvalid = modelComplete;
+  modelInvalid[2][3] = "Element9";
+  invalidModel.setModel(modelInvalid);
+  invalidModel.print();
+  std::cout << "Testing coverage report with invalid row: " << std::endl;
+  CHECKER::setReportFile("test.json");
+  result = CHECKER::checkStream(&invalidModel, p, 2);
+  CHECKER::setReportFile("");
+  std::remove("test2.models");
+  std::ifstream partial("test.json");
+  contents.assign(std::istreambuf_iterator<char>(partial),
+                  std::istreambuf_iterator<char>());
+  partial.close();
+  std::remove("test.json");
+  std::remove("test.models");
+  if (result != 40 || contents.find("\"status\": 40,") == std::string::npos ||
+      contents.find("\"rows\": 2,") == std::string::npos ||
+      contents.find("\"name\": \"rows\"") == std::string::npos) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests CHECKER::diff() function
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testDiff() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Pair Element2, ElementB is missing
+  std::vector<std::vector<std::string>> modelMissingPair = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementY"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementX"},
+      {"CategoryC", "ElementY", "CategoryA", "Element2", "CategoryB",
+       "ElementA"}};
+
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelMissingPair);
+  m->print();
+
+  // Test coverage diff against the model missing a pair
+  MODEL completeModel = MODEL(p, "test2.models");
+  completeModel.setModel(modelComplete);
+  completeModel.print();
+  std::cout << "Testing coverage diff: " << std::endl;
+  std::ostringstream diffOutput;
+  std::streambuf *console = std::cout.rdbuf(diffOutput.rdbuf());
+  result = CHECKER::diff(m, &completeModel, p, 2);
+  std::cout.rdbuf(console);
+  std::remove("test.models");
+  std::remove("test2.models");
+  if (result != 0 ||
+      diffOutput.str().find(
+          "Rows in both files: 2\n"
+          "CategoryA Element1, CategoryB ElementB, CategoryC ElementY\n"
+          "CategoryA Element2, CategoryB ElementA, CategoryC ElementY\n") ==
+          std::string::npos ||
+      diffOutput.str().find("Pairs only covered by test.models: 0\n") ==
+          std::string::npos ||
+      diffOutput.str().find("Pairs only covered by test2.models: 1\n"
+                            "CategoryA Element2, CategoryB ElementB\n") ==
+          std::string::npos) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests CHECKER::checkIncremental() function
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testIncremental() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Test incremental check, the second run continues behind the checked rows
+  // and still knows the combinations covered by them
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  m->print();
+  std::cout << "Testing incremental check with checkpoint: " << std::endl;
+  result = CHECKER::checkIncremental(m, p, 2);
+  CHECKPOINT checkpoint;
+  std::size_t fileSize = 0;
+  bool stored = false;
+  if (result == 0 && checkpoint.read("test.models.checkpoint") == 0) {
+    std::ifstream file("test.models", std::ios::binary | std::ios::ate);
+    fileSize = static_cast<std::size_t>(file.tellg());
+    stored = checkpoint.getRows() == 4 && checkpoint.getOffset() == fileSize;
+  }
+  if (!stored) {
+    std::remove("test.models");
+    std::remove("test.models.checkpoint");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // A row changed in place in the checked part does not match the hash in
+  // the checkpoint, so the whole file is checked again
+  std::cout << "Testing incremental check after checked row changed: "
+            << std::endl;
+  std::string content;
+  {
+    std::fstream file("test.models",
+                      std::ios::in | std::ios::out | std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+    file.seekp(content.find("Element1"));
+    file << "Element9";
+  }
+  {
+    std::ofstream file("test.models", std::ios::binary | std::ios::app);
+    file << "CategoryA,Element1,CategoryB,ElementB,CategoryC,ElementY\n"
+         << "CategoryA,Element2,CategoryB,ElementA,CategoryC,ElementY\n";
+  }
+  std::ostringstream errors;
+  std::streambuf *console = std::cerr.rdbuf(errors.rdbuf());
+  result = CHECKER::checkIncremental(m, p, 2);
+  std::cerr.rdbuf(console);
+  if (result != 40 ||
+      errors.str().find("Error in row 1 of test.models") ==
+          std::string::npos ||
+      checkpoint.read("test.models.checkpoint") != 0 ||
+      checkpoint.getRows() != 4) {
+    std::remove("test.models");
+    std::remove("test.models.checkpoint");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // With the checked part restored the check continues at the first
+  // appended row
+  std::cout << "Testing incremental check of appended rows: " << std::endl;
+  {
+    std::fstream file("test.models",
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(content.find("Element1"));
+    file << "Element1";
+  }
+  std::ostringstream log;
+  LOGGER::SetVerboseMode(true);
+  console = std::cout.rdbuf(log.rdbuf());
+  result = CHECKER::checkIncremental(m, p, 2);
+  std::cout.rdbuf(console);
+  LOGGER::SetVerboseMode(false);
+  stored = false;
+  if (result == 0 && checkpoint.read("test.models.checkpoint") == 0) {
+    std::ifstream file("test.models", std::ios::binary | std::ios::ate);
+    std::size_t appendedSize = static_cast<std::size_t>(file.tellg());
+    stored = checkpoint.getRows() == 6 && appendedSize > fileSize &&
+             checkpoint.getOffset() == appendedSize;
+  }
+  if (!stored || log.str().find("Continuing check of test.models at row 5") ==
+                     std::string::npos) {
+    std::remove("test.models");
+    std::remove("test.models.checkpoint");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // An invalid appended row is reported with its row number in the whole
+  // file and leaves the checkpoint unchanged
+  std::cout << "Testing incremental check of appended invalid row: "
+            << std::endl;
+  {
+    std::ofstream file("test.models", std::ios::binary | std::ios::app);
+    file << "CategoryA,Element9,CategoryB,ElementA,CategoryC,ElementX\n";
+  }
+  errors.str("");
+  console = std::cerr.rdbuf(errors.rdbuf());
+  result = CHECKER::checkIncremental(m, p, 2);
+  std::cerr.rdbuf(console);
+  if (result != 40 ||
+      errors.str().find("Error in row 7 of test.models") == std::string::npos ||
+      checkpoint.read("test.models.checkpoint") != 0 ||
+      checkpoint.getRows() != 6) {
+    std::remove("test.models");
+    std::remove("test.models.checkpoint");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Changed options do not match the checkpoint, so the whole file is checked
+  // again
+  std::cout << "Testing incremental check after options changed: "
+            << std::endl;
+  std::vector<std::vector<std::string>> optionsChanged = options;
+  optionsChanged[0].push_back("Element3");
+  p->setOptions(optionsChanged);
+  log.str("");
+  errors.str("");
+  LOGGER::SetVerboseMode(true);
+  console = std::cout.rdbuf(log.rdbuf());
+  std::streambuf *errorConsole = std::cerr.rdbuf(errors.rdbuf());
+  result = CHECKER::checkIncremental(m, p, 2);
+  std::cerr.rdbuf(errorConsole);
+  std::cout.rdbuf(console);
+  LOGGER::SetVerboseMode(false);
+  p->setOptions(options);
+  std::remove("test.models");
+  std::remove("test.models.checkpoint");
+  if (result != 40 ||
+      log.str().find("Continuing check") != std::string::npos ||
+      errors.str().find("Error in row 7 of test.models") ==
+          std::string::npos) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests reading and writing compressed models files
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testCompression() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Test gzip compressed models file, written and read back while streaming
+  // and after decompressing it completely
+  MODEL compressedModel = MODEL(p, "test.models.gz");
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  compressedModel.setModel(modelComplete);
+  std::cout << "Testing compressed models file: " << std::endl;
+  result = compressedModel.print();
+  if (result == 0) {
+    result = CHECKER::checkStream(&compressedModel, p, 2);
+  }
+  if (result == 0) {
+    result = compressedModel.map();
+  }
+  if (result == 0) {
+    result = CHECKER::check(&compressedModel, p, 2);
+  }
+  std::remove("test.models.gz");
+  if (result != 0) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests writing models files through WRITER
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testWriter() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Test that an unfinished file does not replace the previous models file
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  result = m->print();
+  {
+    WRITER unfinished("test.models");
+    unfinished << "CategoryA,Element1\n";
+  }
+  std::cout << "Testing unfinished models file: " << std::endl;
+  if (result == 0) {
+    result = m->map();
+  }
+  if (result == 0) {
+    result = CHECKER::check(m, p, 2);
+  }
+  std::remove("test.models");
+  if (result != 0) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test that formatting a large models file on several threads writes the
+  // same bytes as a single thread
+  std::vector<std::vector<std::string>> modelLarge;
+  for (int i = 0; i < 50000; i++) {
+    modelLarge.push_back(modelComplete[i % modelComplete.size()]);
+  }
+  modelLarge[123][1] = "Element,1";
+  m->setModel(modelLarge);
+  std::cout << "Testing models file formatted on several threads: "
+            << std::endl;
+  PARALLEL::setThreads(1);
+  result = m->print();
+  std::ifstream single("test.models", std::ios::binary);
+  std::string singleBytes((std::istreambuf_iterator<char>(single)),
+                          std::istreambuf_iterator<char>());
+  single.close();
+  PARALLEL::setThreads(4);
+  if (result == 0) {
+    result = m->print();
+  }
+  PARALLEL::setThreads(0);
+  std::ifstream several("test.models", std::ios::binary);
+  std::string severalBytes((std::istreambuf_iterator<char>(several)),
+                           std::istreambuf_iterator<char>());
+  several.close();
+  std::remove("test.models");
+  if (result != 0 || singleBytes.empty() || singleBytes != severalBytes) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests binary models files (see BINARY)
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testBinaryModels() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Test binary models file, the rows come back in the order of the options
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  std::cout << "Testing binary models file: " << std::endl;
+  result = PRETTYPRINT::printBinaryModels(m);
+  if (result == 0) {
+    result = m->parse();
+  }
+  std::vector<std::vector<std::string>> binaryRows = m->getModels();
+  if (result == 0) {
+    result = m->map();
+  }
+  if (result == 0) {
+    result = CHECKER::check(m, p, 2);
+  }
+  if (result != 0 || binaryRows.size() != modelComplete.size() ||
+      binaryRows[2] != std::vector<std::string>{"CategoryA", "Element2",
+                                                "CategoryB", "ElementA",
+                                                "CategoryC", "ElementY"}) {
+    std::remove("test.models");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test damaged binary models file, the checksum does not match anymore
+  std::fstream damaged("test.models", std::ios::in | std::ios::out |
+                                          std::ios::binary | std::ios::ate);
+  damaged.seekp(-9, std::ios::end);
+  damaged.put('\x01');
+  damaged.close();
+  std::cout << "Testing damaged binary models file: " << std::endl;
+  result = m->map();
+  std::remove("test.models");
+  if (result != 10) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test binary models file containing an element the options do not know,
+  // the row has to be reported by name while streaming
+  std::vector<std::vector<std::string>> optionsExtra = options;
+  optionsExtra[0].push_back("Element3");
+  std::vector<std::vector<std::string>> modelExtra = modelComplete;
+  modelExtra[1][1] = "Element3";
+  p->setOptions(optionsExtra);
+  m->setModel(modelExtra);
+  std::cout << "Testing binary models file with unknown element: "
+            << std::endl;
+  result = PRETTYPRINT::printBinaryModels(m);
+  p->setOptions(options);
+  if (result == 0) {
+    result = CHECKER::checkStream(m, p, 2);
+  }
+  std::remove("test.models");
+  if (result != 40) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests columnar models files with a header row
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testColumnModels() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Test columnar models file, parsed rows come back as pairs in the order
+  // of the options
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  std::cout << "Testing columnar models file: " << std::endl;
+  result = PRETTYPRINT::printColumnModels(m);
+  if (result == 0) {
+    result = m->parse();
+  }
+  std::vector<std::vector<std::string>> columnRows = m->getModels();
+  if (result == 0) {
+    result = CHECKER::checkStream(m, p, 2);
+  }
+  if (result == 0) {
+    result = m->map();
+  }
+  if (result == 0) {
+    result = CHECKER::check(m, p, 2);
+  }
+  std::remove("test.models");
+  if (result != 0 || columnRows.size() != modelComplete.size() ||
+      columnRows[2] != std::vector<std::string>{"CategoryA", "Element2",
+                                                "CategoryB", "ElementA",
+                                                "CategoryC", "ElementY"}) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test columnar models file with an unknown element in the second row
+  m->setModel(modelComplete);
+  result = PRETTYPRINT::printColumnModels(m);
+  {
+    std::ofstream columnar("test.models", std::ios::app);
+    columnar << "Element3,ElementA,ElementX\n";
+  }
+  std::cout << "Testing columnar models file with unknown element: "
+            << std::endl;
+  if (result == 0) {
+    result = m->map();
+  }
+  if (result == 0) {
+    result = CHECKER::check(m, p, 2);
+  }
+  std::remove("test.models");
+  if (result != 40) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests models files kept in memory (see MEMORY)
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testMemory() {
+  PROBLEM test = PROBLEM("test.options", "test.constraints"); // Sample problem
+  PROBLEM *p = &test;                        // Pointer to sample problem
+  MODEL testModel = MODEL(p, "test.models"); // Sample model
+  MODEL *m = &testModel;                     // Pointer to test model
+  int result;                                // Temporarily stores result
+
+  std::vector<std::vector<std::string>> options = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB"},
+      {"CategoryC", "ElementX", "ElementY"}};
+
+  std::vector<std::vector<std::string>> constraintsNone = {};
+
+  std::vector<std::vector<std::string>> modelComplete = {
+      {"CategoryA", "Element1", "CategoryB", "ElementA", "CategoryC",
+       "ElementX"},
+      {"CategoryA", "Element1", "CategoryB", "ElementB", "CategoryC",
+       "ElementY"},
+      {"CategoryB", "ElementA", "CategoryA", "Element2", "CategoryC",
+       "ElementY"},
+      {"CategoryC", "ElementX", "CategoryA", "Element2", "CategoryB",
+       "ElementB"}};
+
+  // Test models file kept in memory, nothing is written to disk
+  p->setOptions(options);
+  p->setConstraints(constraintsNone);
+  m->setModel(modelComplete);
+  m->setModelsFile("mem:test.models");
+  std::cout << "Testing models file in memory: " << std::endl;
+  result = m->print();
+  std::string memoryData;
+  if (result == 0 && !MEMORY::read("mem:test.models", memoryData)) {
+    result = 10;
+  }
+  if (result == 0) {
+    result = m->parse();
+  }
+  std::vector<std::vector<std::string>> memoryRows = m->getModels();
+  if (result == 0) {
+    result = CHECKER::checkStream(m, p, 2);
+  }
+  if (result == 0) {
+    result = m->map();
+  }
+  if (result == 0) {
+    result = CHECKER::check(m, p, 2);
+  }
+  MEMORY::remove("mem:test.models");
+  m->setModelsFile("test.models");
+  if (result != 0 || memoryRows != modelComplete ||
+      memoryData.compare(0, 20, "CategoryA,Element1,C") != 0) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Main Function                                                            //
+/////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief runs all tests for CHECKER
+ *
+ * @return int status code (see documentation)
+ */
+int main() {
+  //Set this to true to enable verbose logging to console
+  LOGGER::SetVerboseMode(false);
+  
+  int counter = 0;
+  bool input = 0;
+  std::cout << "Checker Test" << std::endl;
+  std::cout << "-------------------------------------" << std::endl;
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of checkInputFiles()" << std::endl;
+  input = testInputFiles();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of checkOptionsCoverage()" << std::endl;
+  input = testOptionsCoverage();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of checkConstraints()" << std::endl;
+  input = testConstraints();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of checkOptionsValid()" << std::endl;
+  input = testOptionsValid();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of findInfeasiblePairs()" << std::endl;
+  input = testInfeasiblePairs();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of checkCoverage()" << std::endl;
+  input = testCoverage();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of checkStream()" << std::endl;
+  input = testStream();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of mapped models files" << std::endl;
+  input = testMappedModels();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of coverage report" << std::endl;
+  input = testReport();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of diff()" << std::endl;
+  input = testDiff();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of checkIncremental()" << std::endl;
+  input = testIncremental();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of compressed models files" << std::endl;
+  input = testCompression();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of WRITER" << std::endl;
+  input = testWriter();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of binary models files" << std::endl;
+  input = testBinaryModels();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of columnar models files" << std::endl;
+  input = testColumnModels();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of memory files" << std::endl;
+  input = testMemory();
   if (input) {
     counter++;
   }
 
   std::cout << "-------------------------------------" << std::endl;
 
-  std::cout << "Testing complete, passed " << counter << " of 4 test groups"
+  std::cout << "Testing complete, passed " << counter << " of 16 test groups"
             << std::endl;
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,182 @@
+/**
+ * @file checkpoint.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for CHECKPOINT class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "checkpoint.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+// Initialize the static member variable outside the class definition
+const std::uint64_t CHECKPOINT::emptyHash = 14695981039346656037ull;
+
+CHECKPOINT::CHECKPOINT()
+    : m_strength{0}, m_optionsHash{0}, m_constraintsHash{0}, m_offset{0},
+      m_fileHash{emptyHash}, m_rows{0} {}
+
+CHECKPOINT::CHECKPOINT(int strength, std::uint64_t optionsHash,
+                       std::uint64_t constraintsHash, std::size_t offset,
+                       std::uint64_t fileHash, std::size_t rows,
+                       std::vector<std::uint64_t> bits)
+    : m_strength{strength}, m_optionsHash{optionsHash},
+      m_constraintsHash{constraintsHash}, m_offset{offset},
+      m_fileHash{fileHash}, m_rows{rows}, m_bits{bits} {}
+
+CHECKPOINT::~CHECKPOINT() {}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+int CHECKPOINT::read(const std::string &filename) {
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    return 10;
+  }
+
+  // Every value is preceded by its name
+  std::string header, name;
+  int version = 0;
+  std::size_t words = 0;
+  file >> header >> version;
+  if (header != "pairwise-checkpoint" || version != 2) {
+    return 50;
+  }
+  file >> name >> m_strength;
+  file >> name >> std::hex >> m_optionsHash;
+  file >> name >> m_constraintsHash >> std::dec;
+  file >> name >> m_offset;
+  file >> name >> std::hex >> m_fileHash >> std::dec;
+  file >> name >> m_rows;
+  file >> name >> words;
+
+  m_bits.assign(words, 0);
+  file >> std::hex;
+  for (std::uint64_t &word : m_bits) {
+    file >> word;
+  }
+  if (!file) {
+    LOGGER_INFO << "Malformed checkpoint file: " << filename << std::endl;
+    return 50;
+  }
+  return 0;
+}
+
+int CHECKPOINT::write(const std::string &filename) const {
+  std::string temporary = filename + ".tmp";
+  std::ofstream file(temporary);
+  if (!file.is_open()) {
+    LOGGER_INFO << "Error opening file: " << temporary << std::endl;
+    return 10;
+  }
+
+  file << "pairwise-checkpoint 2\n";
+  file << "strength " << m_strength << "\n";
+  file << std::hex;
+  file << "options " << m_optionsHash << "\n";
+  file << "constraints " << m_constraintsHash << "\n";
+  file << std::dec;
+  file << "offset " << m_offset << "\n";
+  file << "file " << std::hex << m_fileHash << std::dec << "\n";
+  file << "rows " << m_rows << "\n";
+  file << "bits " << m_bits.size() << "\n";
+  file << std::hex;
+  for (std::size_t i = 0; i < m_bits.size(); i++) {
+    file << m_bits[i] << ((i % 8 == 7) ? "\n" : " ");
+  }
+  file << "\n";
+  file.close();
+  if (!file) {
+    std::remove(temporary.c_str());
+    return 10;
+  }
+
+  // Replace old checkpoint in one step
+  if (std::rename(temporary.c_str(), filename.c_str())) {
+    std::remove(temporary.c_str());
+    return 10;
+  }
+  return 0;
+}
+
+bool CHECKPOINT::matches(int strength, std::uint64_t optionsHash,
+                         std::uint64_t constraintsHash,
+                         const std::string &modelsFile) const {
+  if (strength != m_strength || optionsHash != m_optionsHash ||
+      constraintsHash != m_constraintsHash) {
+    return false;
+  }
+  // The checked part must still exist unchanged, appending rows does not
+  // change the hash of the bytes before the offset
+  std::uint64_t fileHash = emptyHash;
+  return hashFile(modelsFile, 0, m_offset, fileHash) &&
+         fileHash == m_fileHash;
+}
+
+std::uint64_t
+CHECKPOINT::hash(const std::vector<std::vector<std::string>> &rows) {
+  // FNV-1a, the length of every entry and row is included so that moving
+  // characters between entries changes the hash
+  std::uint64_t value = emptyHash;
+  auto add = [&value](std::uint64_t number) {
+    for (int i = 0; i < 8; i++) {
+      value = (value ^ ((number >> (8 * i)) & 0xff)) * 1099511628211ull;
+    }
+  };
+  for (const auto &row : rows) {
+    add(row.size());
+    for (const auto &entry : row) {
+      add(entry.size());
+      for (unsigned char c : entry) {
+        value = (value ^ c) * 1099511628211ull;
+      }
+    }
+  }
+  return value;
+}
+
+bool CHECKPOINT::hashFile(const std::string &filename, std::size_t begin,
+                          std::size_t end, std::uint64_t &value) {
+  if (begin == end) {
+    return true;
+  }
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open() || !file.seekg(begin)) {
+    return false;
+  }
+
+  // FNV-1a over the bytes, read in blocks
+  std::vector<char> buffer(1 << 16);
+  std::size_t remaining = end - begin;
+  while (remaining > 0) {
+    std::size_t size = std::min(remaining, buffer.size());
+    if (!file.read(buffer.data(), size)) {
+      return false;
+    }
+    for (std::size_t i = 0; i < size; i++) {
+      value = (value ^ static_cast<unsigned char>(buffer[i])) *
+              1099511628211ull;
+    }
+    remaining -= size;
+  }
+  return true;
+}
+
+std::size_t CHECKPOINT::getOffset() const { return m_offset; }
+
+std::uint64_t CHECKPOINT::getFileHash() const { return m_fileHash; }
+
+std::size_t CHECKPOINT::getRows() const { return m_rows; }
+
+const std::vector<std::uint64_t> &CHECKPOINT::getBits() const {
+  return m_bits;
+}
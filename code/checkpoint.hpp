@@ -0,0 +1,179 @@
+/**
+ * @file checkpoint.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for CHECKPOINT class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_CHECKPOINT
+#define PAIRWISE_CHECKPOINT
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief State of a partially checked .models file, stored in a small text
+ * file so a later check only has to look at the rows appended since
+ * @note The checkpoint is only valid for the options, constraints and strength
+ * it was created with and for the checked part of the .models file, these are
+ * compared using the stored hashes.
+ */
+class CHECKPOINT {
+public:
+  CHECKPOINT();
+  /**
+   * @brief Construct a new CHECKPOINT object
+   *
+   * @param strength number of categories per combination of the bitmap
+   * @param optionsHash hash of the options (see CHECKPOINT::hash())
+   * @param constraintsHash hash of the constraints (see CHECKPOINT::hash())
+   * @param offset byte offset behind the last checked row
+   * @param fileHash hash of the checked part of the .models file (see
+   * CHECKPOINT::hashFile())
+   * @param rows number of checked rows
+   * @param bits coverage bitmap of the checked rows (see COVERAGE::getWords())
+   */
+  CHECKPOINT(int strength, std::uint64_t optionsHash,
+             std::uint64_t constraintsHash, std::size_t offset,
+             std::uint64_t fileHash, std::size_t rows,
+             std::vector<std::uint64_t> bits);
+  ~CHECKPOINT();
+
+  /**
+   * @brief Reads a checkpoint file
+   *
+   * @param filename name of the checkpoint file
+   * @return int status code (see documentation), 50 if the file is malformed
+   */
+  int read(const std::string &filename);
+
+  /**
+   * @brief Writes the checkpoint file
+   * @note The file is written under a temporary name first and then renamed,
+   * so an interrupted run never leaves a broken checkpoint behind
+   *
+   * @param filename name of the checkpoint file
+   * @return int status code (see documentation)
+   */
+  int write(const std::string &filename) const;
+
+  /**
+   * @brief Checks if the checkpoint can be used to continue checking a file
+   * @note The .models file is expected to only grow by appending rows, the
+   * checked part is read again and has to match the stored hash. Any change
+   * to it, including a file replaced by a new one, leads to a full check.
+   *
+   * @param strength number of categories per combination of the new check
+   * @param optionsHash hash of the current options
+   * @param constraintsHash hash of the current constraints
+   * @param modelsFile name of the .models file
+   * @return true if checking can continue at #m_offset
+   * @return false if the complete file has to be checked
+   */
+  bool matches(int strength, std::uint64_t optionsHash,
+               std::uint64_t constraintsHash,
+               const std::string &modelsFile) const;
+
+  /**
+   * @brief Calculates a hash of a csv file's contents that does not change
+   * between runs
+   *
+   * @param rows parsed contents of the file
+   * @return std::uint64_t hash value
+   */
+  static std::uint64_t
+  hash(const std::vector<std::vector<std::string>> &rows);
+
+  /**
+   * @brief Hash of an empty file, the starting value for hashFile()
+   */
+  static const std::uint64_t emptyHash;
+
+  /**
+   * @brief Continues a hash of a file's contents with the bytes from begin
+   * to end, so the hash of a growing file can be extended without reading
+   * the start again
+   *
+   * @param filename name of the file
+   * @param begin offset of the first byte, the bytes before it are already
+   * part of value
+   * @param end offset behind the last byte
+   * @param value hash of the bytes before begin (emptyHash if begin is 0),
+   * receives the hash of the bytes before end
+   * @return true if the file could be read up to end
+   * @return false otherwise, value is undefined
+   */
+  static bool hashFile(const std::string &filename, std::size_t begin,
+                       std::size_t end, std::uint64_t &value);
+
+  /**
+   * @brief Get the #m_offset
+   *
+   * @return std::size_t byte offset behind the last checked row
+   */
+  std::size_t getOffset() const;
+
+  /**
+   * @brief Get the #m_fileHash
+   *
+   * @return std::uint64_t hash of the checked part of the .models file
+   */
+  std::uint64_t getFileHash() const;
+
+  /**
+   * @brief Get the #m_rows
+   *
+   * @return std::size_t number of checked rows
+   */
+  std::size_t getRows() const;
+
+  /**
+   * @brief Get the #m_bits
+   *
+   * @return const std::vector<std::uint64_t>& coverage bitmap
+   */
+  const std::vector<std::uint64_t> &getBits() const;
+
+private:
+  /**
+   * @brief Number of categories per combination of the bitmap
+   */
+  int m_strength;
+
+  /**
+   * @brief Hash of the options the rows were checked against
+   */
+  std::uint64_t m_optionsHash;
+
+  /**
+   * @brief Hash of the constraints the rows were checked against
+   */
+  std::uint64_t m_constraintsHash;
+
+  /**
+   * @brief Byte offset behind the last checked row
+   */
+  std::size_t m_offset;
+
+  /**
+   * @brief Hash of the bytes of the .models file before #m_offset
+   */
+  std::uint64_t m_fileHash;
+
+  /**
+   * @brief Number of checked rows
+   */
+  std::size_t m_rows;
+
+  /**
+   * @brief Coverage bitmap of the checked rows
+   */
+  std::vector<std::uint64_t> m_bits;
+};
+
+#endif
@@ -0,0 +1,388 @@
+/**
+ * @file compression.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for COMPRESSION, INFLATESTREAM and
+ * DEFLATESTREAM classes
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "compression.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+// Initialize the static member variable outside the class definition
+const std::size_t COMPRESSION::bufferSize = 1 << 16;
+
+INFLATESTREAM::INFLATESTREAM(const std::string &filename, bool zstd)
+    : std::istream(nullptr), m_file(filename, std::ios::binary),
+      m_buffer(m_file, zstd) {
+  rdbuf(&m_buffer);
+}
+
+INFLATESTREAM::~INFLATESTREAM() {}
+
+INFLATESTREAM::BUFFER::BUFFER(std::istream &source, bool zstd)
+    : m_source(source), m_zstd{zstd}, m_finished{false},
+      m_in(new char[COMPRESSION::bufferSize]), m_position{0},
+      m_available{0}, m_out(new char[COMPRESSION::bufferSize]) {
+  std::memset(&m_zlib, 0, sizeof(m_zlib));
+  if (m_zstd) {
+#ifdef PAIRWISE_ZSTD
+    m_zstdStream = ZSTD_createDStream();
+    ZSTD_initDStream(m_zstdStream);
+#endif
+  } else {
+    // 16 selects the gzip format
+    inflateInit2(&m_zlib, 15 + 16);
+  }
+}
+
+INFLATESTREAM::BUFFER::~BUFFER() {
+  if (m_zstd) {
+#ifdef PAIRWISE_ZSTD
+    ZSTD_freeDStream(m_zstdStream);
+#endif
+  } else {
+    inflateEnd(&m_zlib);
+  }
+}
+
+DEFLATESTREAM::DEFLATESTREAM(const std::string &filename, bool zstd,
+                             bool direct)
+    : std::ostream(nullptr), m_file(filename, direct),
+      m_buffer(m_file, zstd) {
+  rdbuf(&m_buffer);
+}
+
+DEFLATESTREAM::~DEFLATESTREAM() {}
+
+DEFLATESTREAM::BUFFER::BUFFER(std::ostream &target, bool zstd)
+    : m_target(target), m_zstd{zstd}, m_finished{false},
+      m_in(new char[COMPRESSION::bufferSize]),
+      m_out(new char[COMPRESSION::bufferSize]) {
+  setp(m_in.get(), m_in.get() + COMPRESSION::bufferSize);
+  std::memset(&m_zlib, 0, sizeof(m_zlib));
+  if (m_zstd) {
+#ifdef PAIRWISE_ZSTD
+    m_zstdStream = ZSTD_createCCtx();
+#endif
+  } else {
+    deflateInit2(&m_zlib, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                 Z_DEFAULT_STRATEGY);
+  }
+}
+
+DEFLATESTREAM::BUFFER::~BUFFER() {
+  if (m_zstd) {
+#ifdef PAIRWISE_ZSTD
+    ZSTD_freeCCtx(m_zstdStream);
+#endif
+  } else {
+    deflateEnd(&m_zlib);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+bool COMPRESSION::isCompressed(std::string_view data) {
+  return data.substr(0, 2) == "\x1f\x8b" ||
+         data.substr(0, 4) == "\x28\xb5\x2f\xfd";
+}
+
+int COMPRESSION::decompress(const std::string &filename, std::string_view data,
+                            std::string &out) {
+  out.clear();
+  bool zstd = data.substr(0, 2) != "\x1f\x8b";
+  bool damaged = false;
+  if (zstd) {
+#ifdef PAIRWISE_ZSTD
+    ZSTD_DStream *stream = ZSTD_createDStream();
+    ZSTD_initDStream(stream);
+    ZSTD_inBuffer in = {data.data(), data.size(), 0};
+    std::size_t result = 0;
+    while (!damaged && (in.pos < in.size || result != 0)) {
+      std::size_t size = out.size();
+      out.resize(size + bufferSize);
+      ZSTD_outBuffer buffer = {&out[size], bufferSize, 0};
+      result = ZSTD_decompressStream(stream, &buffer, &in);
+      out.resize(size + buffer.pos);
+      // The data must not end inside a frame
+      damaged = ZSTD_isError(result) ||
+                (in.pos == in.size && result != 0 && buffer.pos == 0);
+    }
+    ZSTD_freeDStream(stream);
+#else
+    std::cerr << "Error reading file: " << filename
+              << " is compressed with zstd, which is not supported by this "
+                 "build"
+              << std::endl;
+    return 10;
+#endif
+  } else {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    inflateInit2(&stream, 15 + 16);
+    stream.next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream.avail_in = data.size();
+    int result = Z_OK;
+    while (!damaged && (stream.avail_in > 0 || result != Z_STREAM_END)) {
+      // A new member starts behind the end of the previous one
+      if (result == Z_STREAM_END) {
+        inflateReset(&stream);
+      }
+      std::size_t size = out.size();
+      out.resize(size + bufferSize);
+      stream.next_out = reinterpret_cast<Bytef *>(&out[size]);
+      stream.avail_out = bufferSize;
+      result = inflate(&stream, Z_NO_FLUSH);
+      out.resize(size + bufferSize - stream.avail_out);
+      damaged = (result != Z_OK && result != Z_STREAM_END) ||
+                (stream.avail_in == 0 && result != Z_STREAM_END &&
+                 stream.avail_out == bufferSize);
+    }
+    inflateEnd(&stream);
+  }
+
+  if (damaged) {
+    std::cerr << "Error reading file: " << filename
+              << " contains damaged compressed data" << std::endl;
+    return 10;
+  }
+  return 0;
+}
+
+std::unique_ptr<std::istream>
+COMPRESSION::openInput(const std::string &filename, bool *compressed) {
+  std::unique_ptr<std::ifstream> file =
+      std::make_unique<std::ifstream>(filename, std::ios::binary);
+  if (!file->is_open()) {
+    return nullptr;
+  }
+
+  // Look at the magic bytes, then start reading from the beginning again
+  char magic[4];
+  file->read(magic, sizeof(magic));
+  std::string_view start(magic, file->gcount());
+  bool zstd = start.substr(0, 2) != "\x1f\x8b";
+  if (compressed) {
+    *compressed = isCompressed(start);
+  }
+  if (!isCompressed(start)) {
+    file->clear();
+    file->seekg(0);
+    return file;
+  }
+#ifndef PAIRWISE_ZSTD
+  if (zstd) {
+    std::cerr << "Error reading file: " << filename
+              << " is compressed with zstd, which is not supported by this "
+                 "build"
+              << std::endl;
+    return nullptr;
+  }
+#endif
+  file.reset();
+  std::unique_ptr<INFLATESTREAM> stream =
+      std::make_unique<INFLATESTREAM>(filename, zstd);
+  if (!stream->is_open()) {
+    return nullptr;
+  }
+  return stream;
+}
+
+std::unique_ptr<std::ostream>
+COMPRESSION::openOutput(const std::string &filename, bool direct) {
+  auto endsWith = [&filename](std::string_view extension) {
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(),
+                            extension.size(), extension) == 0;
+  };
+  bool gzip = endsWith(".gz");
+  bool zstd = endsWith(".zst");
+
+  if (!gzip && !zstd) {
+    std::unique_ptr<WRITER> file = std::make_unique<WRITER>(filename, direct);
+    if (!file->is_open()) {
+      return nullptr;
+    }
+    return file;
+  }
+#ifndef PAIRWISE_ZSTD
+  if (zstd) {
+    std::cerr << "Error writing file: " << filename
+              << " would be compressed with zstd, which is not supported "
+                 "by this build"
+              << std::endl;
+    return nullptr;
+  }
+#endif
+  std::unique_ptr<DEFLATESTREAM> stream =
+      std::make_unique<DEFLATESTREAM>(filename, zstd, direct);
+  if (!stream->is_open()) {
+    return nullptr;
+  }
+  return stream;
+}
+
+bool COMPRESSION::close(std::unique_ptr<std::ostream> &out) {
+  bool written = true;
+  if (DEFLATESTREAM *stream = dynamic_cast<DEFLATESTREAM *>(out.get())) {
+    written = stream->finish();
+  } else if (WRITER *file = dynamic_cast<WRITER *>(out.get())) {
+    written = file->finish();
+  } else {
+    out->flush();
+  }
+  written = written && bool(*out);
+  out.reset();
+  return written;
+}
+
+bool INFLATESTREAM::is_open() const { return m_file.is_open(); }
+
+bool DEFLATESTREAM::is_open() const { return m_file.is_open(); }
+
+bool DEFLATESTREAM::finish() {
+  if (!m_buffer.finish() || !m_file.finish()) {
+    setstate(std::ios::badbit);
+    return false;
+  }
+  return true;
+}
+
+bool DEFLATESTREAM::BUFFER::finish() {
+  if (m_finished) {
+    return true;
+  }
+  bool written = compress(true);
+  m_target.flush();
+  return written && m_target;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper Functions                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+INFLATESTREAM::BUFFER::int_type INFLATESTREAM::BUFFER::underflow() {
+  while (gptr() == egptr()) {
+    // Read next block of compressed data
+    if (m_position == m_available) {
+      m_source.read(m_in.get(), COMPRESSION::bufferSize);
+      m_available = m_source.gcount();
+      m_position = 0;
+      if (m_available == 0) {
+        // The file must not end inside a member
+        if (!m_finished) {
+          throw std::runtime_error("incomplete compressed data");
+        }
+        return traits_type::eof();
+      }
+    }
+
+    std::size_t produced = 0;
+    if (m_zstd) {
+#ifdef PAIRWISE_ZSTD
+      ZSTD_inBuffer in = {m_in.get(), m_available, m_position};
+      ZSTD_outBuffer out = {m_out.get(), COMPRESSION::bufferSize, 0};
+      std::size_t result = ZSTD_decompressStream(m_zstdStream, &out, &in);
+      if (ZSTD_isError(result)) {
+        throw std::runtime_error("damaged compressed data");
+      }
+      m_position = in.pos;
+      produced = out.pos;
+      m_finished = result == 0;
+#else
+      throw std::runtime_error("zstd is not supported by this build");
+#endif
+    } else {
+      // A new member starts behind the end of the previous one
+      if (m_finished) {
+        inflateReset(&m_zlib);
+        m_finished = false;
+      }
+      m_zlib.next_in = reinterpret_cast<Bytef *>(m_in.get() + m_position);
+      m_zlib.avail_in = m_available - m_position;
+      m_zlib.next_out = reinterpret_cast<Bytef *>(m_out.get());
+      m_zlib.avail_out = COMPRESSION::bufferSize;
+      int result = inflate(&m_zlib, Z_NO_FLUSH);
+      if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+        throw std::runtime_error("damaged compressed data");
+      }
+      m_position = m_available - m_zlib.avail_in;
+      produced = COMPRESSION::bufferSize - m_zlib.avail_out;
+      m_finished = result == Z_STREAM_END;
+    }
+    setg(m_out.get(), m_out.get(), m_out.get() + produced);
+  }
+  return traits_type::to_int_type(*gptr());
+}
+
+DEFLATESTREAM::BUFFER::int_type DEFLATESTREAM::BUFFER::overflow(int_type c) {
+  if (!compress(false)) {
+    return traits_type::eof();
+  }
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+int DEFLATESTREAM::BUFFER::sync() {
+  if (!compress(false) || !m_target.flush()) {
+    return -1;
+  }
+  return 0;
+}
+
+bool DEFLATESTREAM::BUFFER::compress(bool end) {
+  std::size_t size = pptr() - pbase();
+  if (m_finished) {
+    return size == 0;
+  }
+
+  if (m_zstd) {
+#ifdef PAIRWISE_ZSTD
+    ZSTD_inBuffer in = {pbase(), size, 0};
+    std::size_t remaining;
+    do {
+      ZSTD_outBuffer out = {m_out.get(), COMPRESSION::bufferSize, 0};
+      remaining = ZSTD_compressStream2(m_zstdStream, &out, &in,
+                                       end ? ZSTD_e_end : ZSTD_e_continue);
+      if (ZSTD_isError(remaining)) {
+        return false;
+      }
+      m_target.write(m_out.get(), out.pos);
+    } while (end ? remaining != 0 : in.pos < in.size);
+#else
+    return false;
+#endif
+  } else {
+    m_zlib.next_in = reinterpret_cast<Bytef *>(pbase());
+    m_zlib.avail_in = size;
+    int result;
+    do {
+      m_zlib.next_out = reinterpret_cast<Bytef *>(m_out.get());
+      m_zlib.avail_out = COMPRESSION::bufferSize;
+      result = deflate(&m_zlib, end ? Z_FINISH : Z_NO_FLUSH);
+      if (result == Z_STREAM_ERROR) {
+        return false;
+      }
+      m_target.write(m_out.get(),
+                     COMPRESSION::bufferSize - m_zlib.avail_out);
+    } while (end ? result != Z_STREAM_END : m_zlib.avail_out == 0);
+  }
+
+  setp(m_in.get(), m_in.get() + COMPRESSION::bufferSize);
+  m_finished = end;
+  return bool(m_target);
+}
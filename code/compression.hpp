@@ -0,0 +1,336 @@
+/**
+ * @file compression.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for COMPRESSION, INFLATESTREAM and
+ * DEFLATESTREAM classes
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_COMPRESSION
+#define PAIRWISE_COMPRESSION
+
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+#include "writer.hpp"
+
+#include <zlib.h>
+#ifdef PAIRWISE_ZSTD
+#include <zstd.h>
+#endif
+
+/**
+ * @brief Reads and writes gzip and zstd compressed files
+ * @note Compressed input is recognized by its magic bytes, compressed output
+ * by the extension of the filename (.gz or .zst). zstd is only available if
+ * the program was built with PAIRWISE_ZSTD defined (make ZSTD=1), otherwise
+ * zstd files are rejected with an error.
+ */
+class COMPRESSION {
+public:
+  /**
+   * @brief Size of the buffers used for compressing and decompressing
+   */
+  static const std::size_t bufferSize;
+
+  /**
+   * @brief Checks if data starts with the magic bytes of a gzip or zstd
+   * stream
+   *
+   * @param data first bytes of a file
+   * @return true if the data is compressed
+   * @return false otherwise
+   */
+  static bool isCompressed(std::string_view data);
+
+  /**
+   * @brief Decompresses a complete gzip or zstd stream
+   *
+   * @param filename Filename of the data, used for error messages
+   * @param data compressed data
+   * @param out receives the decompressed data
+   * @return int status code (see documentation), 10 if the data is damaged
+   */
+  static int decompress(const std::string &filename, std::string_view data,
+                        std::string &out);
+
+  /**
+   * @brief Opens a file for reading, compressed files are decompressed while
+   * they are read
+   * @note Reading a damaged compressed file sets the badbit of the stream
+   *
+   * @param filename Filename of the input file
+   * @param compressed if not null, receives whether the file is compressed
+   * @return std::unique_ptr<std::istream> stream, null if the file can not
+   * be opened
+   */
+  static std::unique_ptr<std::istream>
+  openInput(const std::string &filename, bool *compressed = nullptr);
+
+  /**
+   * @brief Opens a file for writing, the data is compressed if the filename
+   * ends with .gz or .zst
+   * @note The file is written through a WRITER, so it only replaces an
+   * existing file once close() was called
+   *
+   * @param filename Filename of the output file
+   * @param direct true to write the file directly instead of replacing it
+   * at the end, see WRITER
+   * @return std::unique_ptr<std::ostream> stream, null if the file can not
+   * be opened
+   */
+  static std::unique_ptr<std::ostream> openOutput(const std::string &filename,
+                                                  bool direct = false);
+
+  /**
+   * @brief Finishes and closes a stream returned by openOutput()
+   *
+   * @param out stream to be closed, reset afterwards
+   * @return true if all data was written
+   * @return false otherwise
+   */
+  static bool close(std::unique_ptr<std::ostream> &out);
+};
+
+/**
+ * @brief Input stream decompressing a gzip or zstd file
+ * @note Only a fixed amount of compressed and decompressed data is kept in
+ * memory. Concatenated gzip members are read as one stream.
+ */
+class INFLATESTREAM : public std::istream {
+public:
+  /**
+   * @brief Opens a compressed file
+   *
+   * @param filename Filename of the input file
+   * @param zstd true for zstd, false for gzip
+   */
+  INFLATESTREAM(const std::string &filename, bool zstd);
+  ~INFLATESTREAM();
+
+  /**
+   * @brief Checks if the file could be opened
+   *
+   * @return true if the file is open
+   * @return false otherwise
+   */
+  bool is_open() const;
+
+private:
+  /**
+   * @brief Buffer decompressing the file block by block
+   */
+  class BUFFER : public std::streambuf {
+  public:
+    BUFFER(std::istream &source, bool zstd);
+    ~BUFFER();
+
+  protected:
+    /**
+     * @brief Decompresses the next block, throws if the data is damaged
+     *
+     * @return int_type next character, eof at the end of the stream
+     */
+    int_type underflow() override;
+
+  private:
+    /**
+     * @brief Stream the compressed data is read from
+     */
+    std::istream &m_source;
+
+    /**
+     * @brief True for zstd, false for gzip
+     */
+    bool m_zstd;
+
+    /**
+     * @brief True if the current gzip member or zstd frame is complete
+     */
+    bool m_finished;
+
+    /**
+     * @brief Compressed data, #m_position to #m_available are not processed
+     * yet
+     */
+    std::unique_ptr<char[]> m_in;
+
+    /**
+     * @brief Position of the first unprocessed byte in #m_in
+     */
+    std::size_t m_position;
+
+    /**
+     * @brief Number of bytes in #m_in
+     */
+    std::size_t m_available;
+
+    /**
+     * @brief Decompressed data
+     */
+    std::unique_ptr<char[]> m_out;
+
+    /**
+     * @brief State of zlib
+     */
+    z_stream m_zlib;
+
+#ifdef PAIRWISE_ZSTD
+    /**
+     * @brief State of zstd
+     */
+    ZSTD_DStream *m_zstdStream;
+#endif
+  };
+
+  /**
+   * @brief Compressed file
+   */
+  std::ifstream m_file;
+
+  /**
+   * @brief Decompressing buffer reading from #m_file
+   */
+  BUFFER m_buffer;
+};
+
+/**
+ * @brief Output stream compressing to a gzip or zstd file
+ * @note Only a fixed amount of data is kept in memory, flushing hands the
+ * buffered data to the compressor but does not end a block, so that
+ * flushing after every row does not hurt compression
+ */
+class DEFLATESTREAM : public std::ostream {
+public:
+  /**
+   * @brief Creates a compressed file
+   *
+   * @param filename Filename of the output file
+   * @param zstd true for zstd, false for gzip
+   * @param direct true to write the file directly, see WRITER
+   */
+  DEFLATESTREAM(const std::string &filename, bool zstd, bool direct = false);
+
+  /**
+   * @brief Discards the file if finish() was not called
+   */
+  ~DEFLATESTREAM();
+
+  /**
+   * @brief Checks if the file could be opened
+   *
+   * @return true if the file is open
+   * @return false otherwise
+   */
+  bool is_open() const;
+
+  /**
+   * @brief Compresses the remaining data and ends the stream
+   *
+   * @return true if all data was written
+   * @return false otherwise
+   */
+  bool finish();
+
+private:
+  /**
+   * @brief Buffer compressing the data block by block
+   */
+  class BUFFER : public std::streambuf {
+  public:
+    BUFFER(std::ostream &target, bool zstd);
+    ~BUFFER();
+
+    /**
+     * @brief Compresses the remaining data and ends the stream
+     *
+     * @return true if all data was written
+     * @return false otherwise
+     */
+    bool finish();
+
+  protected:
+    /**
+     * @brief Compresses the full buffer and stores the next character
+     *
+     * @param c next character
+     * @return int_type c, eof if writing failed
+     */
+    int_type overflow(int_type c) override;
+
+    /**
+     * @brief Compresses the buffered data and flushes the file
+     *
+     * @return int 0 on success, -1 if writing failed
+     */
+    int sync() override;
+
+  private:
+    /**
+     * @brief Compresses the buffered data and writes the result
+     *
+     * @param end true to end the stream
+     * @return true if the data was written
+     * @return false otherwise
+     */
+    bool compress(bool end);
+
+    /**
+     * @brief Stream the compressed data is written to
+     */
+    std::ostream &m_target;
+
+    /**
+     * @brief True for zstd, false for gzip
+     */
+    bool m_zstd;
+
+    /**
+     * @brief True if the stream was ended
+     */
+    bool m_finished;
+
+    /**
+     * @brief Data that was not compressed yet
+     */
+    std::unique_ptr<char[]> m_in;
+
+    /**
+     * @brief Compressed data
+     */
+    std::unique_ptr<char[]> m_out;
+
+    /**
+     * @brief State of zlib
+     */
+    z_stream m_zlib;
+
+#ifdef PAIRWISE_ZSTD
+    /**
+     * @brief State of zstd
+     */
+    ZSTD_CCtx *m_zstdStream;
+#endif
+  };
+
+  /**
+   * @brief Compressed file
+   */
+  WRITER m_file;
+
+  /**
+   * @brief Compressing buffer writing to #m_file
+   */
+  BUFFER m_buffer;
+};
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file coverage.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for COVERAGE class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "coverage.hpp"
+
+#include <algorithm>
+
+COVERAGE::COVERAGE() : m_strength{0} {}
+
+COVERAGE::~COVERAGE() {}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+int COVERAGE::init(const DICTIONARY &d, int strength) {
+  int categories = d.getCategoryCount();
+  if (strength < 1) {
+    return 50;
+  }
+
+  m_strength = strength;
+  m_elementCounts.clear();
+  m_categories.clear();
+  m_offsets.clear();
+  m_bits.clear();
+  m_hits.clear();
+
+  for (int c = 0; c < categories; c++) {
+    m_elementCounts.push_back(d.getElementCount(c));
+  }
+
+  // Enumerate all combinations of categories in lexicographic order
+  m_offsets.push_back(0);
+  if (strength <= categories) {
+    std::vector<int> combination(strength);
+    for (int i = 0; i < strength; i++) {
+      combination[i] = i;
+    }
+    while (true) {
+      std::size_t size = 1;
+      for (int c : combination) {
+        size *= m_elementCounts[c];
+      }
+      m_categories.push_back(combination);
+      m_offsets.push_back(m_offsets.back() + size);
+
+      // Advance to next combination
+      int i = strength - 1;
+      while (i >= 0 && combination[i] == categories - strength + i) {
+        i--;
+      }
+      if (i < 0) {
+        break;
+      }
+      combination[i]++;
+      for (int j = i + 1; j < strength; j++) {
+        combination[j] = combination[j - 1] + 1;
+      }
+    }
+  }
+
+  m_bits.resize((m_offsets.back() + 63) / 64);
+  return 0;
+}
+
+std::size_t COVERAGE::addRow(const std::vector<int> &row) {
+  std::size_t added = 0;
+  for (std::size_t i = 0; i < m_categories.size(); i++) {
+    // Calculate index of the combination within its block
+    std::size_t index = 0;
+    for (int c : m_categories[i]) {
+      index = index * m_elementCounts[c] + row[c];
+    }
+    index += m_offsets[i];
+
+    std::uint64_t mask = std::uint64_t(1) << (index % 64);
+    if (!(m_bits[index / 64] & mask)) {
+      m_bits[index / 64] |= mask;
+      added++;
+    }
+    if (!m_hits.empty()) {
+      m_hits[index]++;
+    }
+  }
+  return added;
+}
+
+void COVERAGE::countHits() { m_hits.assign(m_offsets.back(), 0); }
+
+std::uint32_t COVERAGE::getHits(std::size_t index) const {
+  return m_hits.empty() ? 0 : m_hits[index];
+}
+
+void COVERAGE::set(std::size_t index) {
+  m_bits[index / 64] |= std::uint64_t(1) << (index % 64);
+}
+
+void COVERAGE::merge(const COVERAGE &other) {
+  for (std::size_t i = 0; i < m_bits.size(); i++) {
+    m_bits[i] |= other.m_bits[i];
+  }
+  if (!m_hits.empty() && !other.m_hits.empty()) {
+    for (std::size_t i = 0; i < m_hits.size(); i++) {
+      m_hits[i] += other.m_hits[i];
+    }
+  }
+}
+
+bool COVERAGE::isCovered(std::size_t index) const {
+  return m_bits[index / 64] & (std::uint64_t(1) << (index % 64));
+}
+
+void COVERAGE::decode(std::size_t index, std::vector<int> &categories,
+                      std::vector<int> &elements) const {
+  // Find block containing the index
+  std::size_t block =
+      std::upper_bound(m_offsets.begin(), m_offsets.end(), index) -
+      m_offsets.begin() - 1;
+  index -= m_offsets[block];
+
+  categories = m_categories[block];
+  elements.assign(m_strength, 0);
+  for (int i = m_strength - 1; i >= 0; i--) {
+    elements[i] = index % m_elementCounts[categories[i]];
+    index /= m_elementCounts[categories[i]];
+  }
+}
+
+std::size_t COVERAGE::getCount() const { return m_offsets.back(); }
+
+const std::vector<std::vector<int>> &COVERAGE::getCategories() const {
+  return m_categories;
+}
+
+std::size_t COVERAGE::getOffset(std::size_t block) const {
+  return m_offsets[block];
+}
+
+std::size_t COVERAGE::getCoveredCount() const {
+  std::size_t count = 0;
+  for (std::uint64_t word : m_bits) {
+    count += __builtin_popcountll(word);
+  }
+  return count;
+}
+
+const std::vector<std::uint64_t> &COVERAGE::getWords() const {
+  return m_bits;
+}
+
+bool COVERAGE::setWords(const std::vector<std::uint64_t> &words) {
+  if (words.size() != m_bits.size()) {
+    return false;
+  }
+  m_bits = words;
+  return true;
+}
+
+int COVERAGE::getStrength() const { return m_strength; }
@@ -0,0 +1,189 @@
+/**
+ * @file coverage.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for COVERAGE class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_COVERAGE
+#define PAIRWISE_COVERAGE
+
+#include "dictionary.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Bitmap with one bit for every combination of t elements from t
+ * different categories, used to track which combinations are covered by a
+ * set of rows
+ * @note Combinations are numbered by the combination of categories first
+ * (in lexicographic order of the category ids) and then by the element ids,
+ * where the element of the last category changes fastest. For t = 2 this is
+ * the same order in which SOLVER::generatePairs() creates the pairs.
+ */
+class COVERAGE {
+public:
+  COVERAGE();
+  ~COVERAGE();
+
+  /**
+   * @brief Sets up an empty bitmap for all combinations of a problem
+   *
+   * @param d dictionary containing the compiled problem
+   * @param strength number of categories per combination (2 for pairs)
+   * @return int status code (see documentation)
+   */
+  int init(const DICTIONARY &d, int strength);
+
+  /**
+   * @brief Marks all combinations contained in a row as covered
+   *
+   * @param row element ids of the row, indexed by category id
+   * @return std::size_t number of combinations that were not covered before
+   */
+  std::size_t addRow(const std::vector<int> &row);
+
+  /**
+   * @brief Enables counting how many rows cover each combination
+   * @note Uses one counter per combination in addition to the bitmap, so this
+   * is only enabled when the counts are needed (see REPORT)
+   */
+  void countHits();
+
+  /**
+   * @brief Get the number of rows covering a combination
+   *
+   * @param index index of the combination
+   * @return std::uint32_t number of rows, 0 if countHits() was not called
+   */
+  std::uint32_t getHits(std::size_t index) const;
+
+  /**
+   * @brief Marks a single combination as covered
+   *
+   * @param index index of the combination
+   */
+  void set(std::size_t index);
+
+  /**
+   * @brief Marks all combinations covered in another bitmap as covered
+   * @note Both bitmaps must have been set up for the same problem and strength
+   *
+   * @param other bitmap to be merged into this one
+   */
+  void merge(const COVERAGE &other);
+
+  /**
+   * @brief Checks if a combination is covered
+   *
+   * @param index index of the combination
+   * @return true if the combination is covered
+   * @return false otherwise
+   */
+  bool isCovered(std::size_t index) const;
+
+  /**
+   * @brief Translates an index back to the categories and elements of the
+   * combination
+   *
+   * @param index index of the combination
+   * @param categories vector the category ids are written to
+   * @param elements vector the element ids are written to
+   */
+  void decode(std::size_t index, std::vector<int> &categories,
+              std::vector<int> &elements) const;
+
+  /**
+   * @brief Get the number of combinations
+   *
+   * @return std::size_t number of combinations
+   */
+  std::size_t getCount() const;
+
+  /**
+   * @brief Get the combinations of categories, all combinations of elements
+   * of one entry form a contiguous block of indices
+   *
+   * @return const std::vector<std::vector<int>>& category ids of each block
+   */
+  const std::vector<std::vector<int>> &getCategories() const;
+
+  /**
+   * @brief Get the index of the first combination of a block
+   *
+   * @param block number of the block (see getCategories()), the number of
+   * blocks returns getCount()
+   * @return std::size_t index of the first combination
+   */
+  std::size_t getOffset(std::size_t block) const;
+
+  /**
+   * @brief Get the number of covered combinations
+   *
+   * @return std::size_t number of covered combinations
+   */
+  std::size_t getCoveredCount() const;
+
+  /**
+   * @brief Get the words of the bitmap, used to store it in a CHECKPOINT
+   *
+   * @return const std::vector<std::uint64_t>& bitmap, 64 combinations per word
+   */
+  const std::vector<std::uint64_t> &getWords() const;
+
+  /**
+   * @brief Replaces the bitmap by one returned from getWords()
+   *
+   * @param words bitmap, 64 combinations per word
+   * @return true if the bitmap has the right size and was replaced
+   * @return false otherwise
+   */
+  bool setWords(const std::vector<std::uint64_t> &words);
+
+  /**
+   * @brief Get the strength the bitmap was set up for
+   *
+   * @return int number of categories per combination
+   */
+  int getStrength() const;
+
+private:
+  /**
+   * @brief Number of categories per combination
+   */
+  int m_strength;
+
+  /**
+   * @brief Number of elements of each category
+   */
+  std::vector<int> m_elementCounts;
+
+  /**
+   * @brief All combinations of m_strength category ids
+   */
+  std::vector<std::vector<int>> m_categories;
+
+  /**
+   * @brief Index of the first combination of each entry in #m_categories, the
+   * last entry contains the total number of combinations
+   */
+  std::vector<std::size_t> m_offsets;
+
+  /**
+   * @brief One bit per combination
+   */
+  std::vector<std::uint64_t> m_bits;
+
+  /**
+   * @brief Number of rows covering each combination, empty unless
+   * countHits() was called
+   */
+  std::vector<std::uint32_t> m_hits;
+};
+
+#endif
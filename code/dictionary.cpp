@@ -0,0 +1,295 @@
+/**
+ * @file dictionary.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for DICTIONARY class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "dictionary.hpp"
+#include "problem.hpp"
+
+#include <algorithm>
+
+DICTIONARY::DICTIONARY() {}
+
+DICTIONARY::~DICTIONARY() {}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+int DICTIONARY::build(PROBLEM *p) {
+  return build(p->getOptions(), p->getConstraints());
+}
+
+int DICTIONARY::build(const std::vector<std::vector<std::string>> &options,
+                      const std::vector<std::vector<std::string>> &constraints) {
+  m_categories.clear();
+  m_elements.clear();
+  m_categoryIds.clear();
+  m_elementIds.clear();
+  m_constraints.clear();
+  m_constraintIndex.clear();
+  m_firstEntryIndex.clear();
+  m_rules.clear();
+  m_ruleIndex.clear();
+
+  // Store all names first, the lookup tables point into these strings so they
+  // must not be moved anymore once the tables are filled
+  for (const auto &row : options) {
+    if (row.empty()) {
+      return 20;
+    }
+    m_categories.push_back(row[0]);
+    m_elements.push_back(std::vector<std::string>(row.begin() + 1, row.end()));
+  }
+
+  // Fill lookup tables, if a name appears twice the first occurence is used.
+  // The tables are sized up front so they never rehash.
+  m_elementIds.resize(m_categories.size());
+  m_constraintIndex.resize(m_categories.size());
+  m_firstEntryIndex.resize(m_categories.size());
+  m_ruleIndex.resize(m_categories.size());
+  m_categoryIds.reserve(m_categories.size());
+  for (size_t i = 0; i < m_categories.size(); i++) {
+    m_constraintIndex[i].resize(m_elements[i].size());
+    m_firstEntryIndex[i].resize(m_elements[i].size());
+    m_elementIds[i].reserve(m_elements[i].size());
+    m_categoryIds.emplace(m_categories[i], i);
+    for (size_t j = 0; j < m_elements[i].size(); j++) {
+      m_elementIds[i].emplace(m_elements[i][j], j);
+    }
+  }
+
+  // Compile constraints to ids
+  for (const auto &row : constraints) {
+    // Expressions are compiled to programs of their own
+    if (EXPRESSION::isExpression(row)) {
+      EXPRESSION rule;
+      std::string error;
+      if (rule.compile(EXPRESSION::join(row), *this, error)) {
+        return 30;
+      }
+      for (int category : rule.getCategories()) {
+        m_ruleIndex[category].push_back(m_rules.size());
+      }
+      m_rules.push_back(std::move(rule));
+      continue;
+    }
+
+    if (row.size() % 2 != 0) {
+      return 30;
+    }
+    std::vector<std::pair<int, int>> constraint;
+    for (size_t i = 0; i < row.size(); i += 2) {
+      int category = findCategory(row[i]);
+      if (category < 0) {
+        return 30;
+      }
+      int element = findElement(category, row[i + 1]);
+      if (element < 0) {
+        return 30;
+      }
+      // Skip entries that appear multiple times in the same constraint
+      std::pair<int, int> entry(category, element);
+      if (std::find(constraint.begin(), constraint.end(), entry) ==
+          constraint.end()) {
+        constraint.push_back(entry);
+      }
+    }
+    if (constraint.empty()) {
+      return 30;
+    }
+    // Register constraint with each of its elements
+    for (const auto &entry : constraint) {
+      m_constraintIndex[entry.first][entry.second].push_back(
+          m_constraints.size());
+    }
+    // Also register it with its first element only, see
+    // getConstraintsStartingWith()
+    const auto &first = constraint.front();
+    m_firstEntryIndex[first.first][first.second].push_back(
+        m_constraints.size());
+    m_constraints.push_back(constraint);
+  }
+
+  return 0;
+}
+
+int DICTIONARY::findCategory(std::string_view name) const {
+  auto iterator = m_categoryIds.find(name);
+  if (iterator == m_categoryIds.end()) {
+    return -1;
+  }
+  return iterator->second;
+}
+
+int DICTIONARY::findElement(int category, std::string_view name) const {
+  auto iterator = m_elementIds[category].find(name);
+  if (iterator == m_elementIds[category].end()) {
+    return -1;
+  }
+  return iterator->second;
+}
+
+int DICTIONARY::getCategoryCount() const { return m_categories.size(); }
+
+int DICTIONARY::getElementCount(int category) const {
+  return m_elements[category].size();
+}
+
+const std::string &DICTIONARY::getCategoryName(int category) const {
+  return m_categories[category];
+}
+
+const std::string &DICTIONARY::getElementName(int category,
+                                              int element) const {
+  return m_elements[category][element];
+}
+
+const std::vector<std::vector<std::pair<int, int>>> &
+DICTIONARY::getConstraints() const {
+  return m_constraints;
+}
+
+const std::vector<int> &DICTIONARY::getConstraintsWith(int category,
+                                                       int element) const {
+  return m_constraintIndex[category][element];
+}
+
+const std::vector<int> &
+DICTIONARY::getConstraintsStartingWith(int category, int element) const {
+  return m_firstEntryIndex[category][element];
+}
+
+const std::vector<EXPRESSION> &DICTIONARY::getRules() const {
+  return m_rules;
+}
+
+const std::vector<int> &DICTIONARY::getRulesWith(int category) const {
+  return m_ruleIndex[category];
+}
+
+bool DICTIONARY::compileRow(const std::vector<std::string> &row,
+                            std::vector<int> &ids) const {
+  return compile(row, ids);
+}
+
+bool DICTIONARY::compileRow(const FIELDS &row, std::vector<int> &ids) const {
+  return compile(row, ids);
+}
+
+bool DICTIONARY::compileHeader(const std::vector<std::string> &row,
+                               std::vector<int> &columns) const {
+  return header(row, columns);
+}
+
+bool DICTIONARY::compileHeader(const FIELDS &row,
+                               std::vector<int> &columns) const {
+  return header(row, columns);
+}
+
+bool DICTIONARY::compileColumns(const std::vector<std::string> &row,
+                                const std::vector<int> &columns,
+                                std::vector<int> &ids) const {
+  return compileColumnRow(row, columns, ids);
+}
+
+bool DICTIONARY::compileColumns(const FIELDS &row,
+                                const std::vector<int> &columns,
+                                std::vector<int> &ids) const {
+  return compileColumnRow(row, columns, ids);
+}
+
+void DICTIONARY::expandColumns(const std::vector<std::string> &row,
+                               const std::vector<int> &columns,
+                               std::vector<std::string_view> &fields) const {
+  expand(row, columns, fields);
+}
+
+void DICTIONARY::expandColumns(const FIELDS &row,
+                               const std::vector<int> &columns,
+                               std::vector<std::string_view> &fields) const {
+  expand(row, columns, fields);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper Functions                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+template <typename Row>
+bool DICTIONARY::compile(const Row &row, std::vector<int> &ids) const {
+  if (row.size() != 2 * m_categories.size()) {
+    return false;
+  }
+
+  ids.assign(m_categories.size(), -1);
+  for (size_t i = 0; i < row.size(); i += 2) {
+    int category = findCategory(row[i]);
+    if (category < 0 || ids[category] != -1) {
+      return false;
+    }
+    int element = findElement(category, row[i + 1]);
+    if (element < 0) {
+      return false;
+    }
+    ids[category] = element;
+  }
+  return true;
+}
+
+template <typename Row>
+bool DICTIONARY::header(const Row &row, std::vector<int> &columns) const {
+  if (row.size() != m_categories.size() || row.size() == 0) {
+    return false;
+  }
+
+  std::vector<int> found;
+  std::vector<bool> seen(m_categories.size(), false);
+  for (std::size_t i = 0; i < row.size(); i++) {
+    int category = findCategory(row[i]);
+    if (category < 0 || seen[category]) {
+      return false;
+    }
+    seen[category] = true;
+    found.push_back(category);
+  }
+  columns = std::move(found);
+  return true;
+}
+
+template <typename Row>
+bool DICTIONARY::compileColumnRow(const Row &row,
+                                  const std::vector<int> &columns,
+                                  std::vector<int> &ids) const {
+  if (row.size() != columns.size()) {
+    return false;
+  }
+
+  ids.resize(m_categories.size());
+  for (std::size_t i = 0; i < row.size(); i++) {
+    int element = findElement(columns[i], row[i]);
+    if (element < 0) {
+      return false;
+    }
+    ids[columns[i]] = element;
+  }
+  return true;
+}
+
+template <typename Row>
+void DICTIONARY::expand(const Row &row, const std::vector<int> &columns,
+                        std::vector<std::string_view> &fields) const {
+  // Surplus fields have no category, which leaves an odd number of names
+  fields.clear();
+  for (std::size_t i = 0; i < row.size(); i++) {
+    if (i < columns.size()) {
+      fields.push_back(m_categories[columns[i]]);
+    }
+    fields.push_back(row[i]);
+  }
+}
@@ -0,0 +1,355 @@
+/**
+ * @file dictionary.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for DICTIONARY class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_DICTIONARY
+#define PAIRWISE_DICTIONARY
+
+#include "expression.hpp"
+#include "table.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Forward declaration
+class PROBLEM;
+
+/**
+ * @brief Translates the category and element names of a PROBLEM to integer
+ * ids, so that rows and constraints can be handled as vectors of numbers
+ * @note Category ids follow the order of the rows in the options file, element
+ * ids follow the order of the elements within their row.
+ */
+class DICTIONARY {
+public:
+  DICTIONARY();
+  ~DICTIONARY();
+
+  // The lookup tables point into the stored names, so copying is not allowed
+  DICTIONARY(const DICTIONARY &) = delete;
+  DICTIONARY &operator=(const DICTIONARY &) = delete;
+
+  /**
+   * @brief Fills the dictionary with the options and constraints of a problem
+   * @note The problem should have passed CHECKER::checkFiles() beforehand
+   *
+   * @param p reference to instance of problem class containting options and
+   * constraints
+   * @return int status code (see documentation)
+   */
+  int build(PROBLEM *p);
+
+  /**
+   * @brief Fills the dictionary with options and constraints, see build()
+   *
+   * @param options rows of the options file
+   * @param constraints rows of the constraints file
+   * @return int status code (see documentation)
+   */
+  int build(const std::vector<std::vector<std::string>> &options,
+            const std::vector<std::vector<std::string>> &constraints);
+
+  /**
+   * @brief Looks up the id of a category
+   *
+   * @param name name of the category
+   * @return int id of the category, -1 if unknown
+   */
+  int findCategory(std::string_view name) const;
+
+  /**
+   * @brief Looks up the id of an element within a category
+   *
+   * @param category id of the category
+   * @param name name of the element
+   * @return int id of the element, -1 if unknown
+   */
+  int findElement(int category, std::string_view name) const;
+
+  /**
+   * @brief Get the number of categories
+   *
+   * @return int number of categories
+   */
+  int getCategoryCount() const;
+
+  /**
+   * @brief Get the number of elements of a category
+   *
+   * @param category id of the category
+   * @return int number of elements
+   */
+  int getElementCount(int category) const;
+
+  /**
+   * @brief Get the name of a category
+   *
+   * @param category id of the category
+   * @return const std::string& name of the category
+   */
+  const std::string &getCategoryName(int category) const;
+
+  /**
+   * @brief Get the name of an element
+   *
+   * @param category id of the category
+   * @param element id of the element
+   * @return const std::string& name of the element
+   */
+  const std::string &getElementName(int category, int element) const;
+
+  /**
+   * @brief Get the compiled constraints
+   * @note Each constraint is stored as a list of (category, element) ids
+   *
+   * @return const std::vector<std::vector<std::pair<int, int>>>& constraints
+   */
+  const std::vector<std::vector<std::pair<int, int>>> &getConstraints() const;
+
+  /**
+   * @brief Get all constraints that contain a certain element
+   *
+   * @param category id of the category
+   * @param element id of the element
+   * @return const std::vector<int>& ids of the constraints
+   */
+  const std::vector<int> &getConstraintsWith(int category, int element) const;
+
+  /**
+   * @brief Get all constraints whose first entry is a certain element
+   * @note Every constraint is listed under exactly one element, so looking up
+   * all elements of a row finds each relevant constraint once
+   *
+   * @param category id of the category
+   * @param element id of the element
+   * @return const std::vector<int>& ids of the constraints
+   */
+  const std::vector<int> &getConstraintsStartingWith(int category,
+                                                     int element) const;
+
+  /**
+   * @brief Get the compiled expressions of the constraints file
+   * @note A row is valid if no expression evaluates to EXPRESSION::FALSE
+   *
+   * @return const std::vector<EXPRESSION>& expressions
+   */
+  const std::vector<EXPRESSION> &getRules() const;
+
+  /**
+   * @brief Get all expressions that test a certain category
+   *
+   * @param category id of the category
+   * @return const std::vector<int>& ids of the expressions
+   */
+  const std::vector<int> &getRulesWith(int category) const;
+
+  /**
+   * @brief Translates a row of alternating category and element names to
+   * element ids
+   *
+   * @param row row of alternating category and element names
+   * @param ids vector the element ids are written to, indexed by category id
+   * @return true if the row contains every category exactly once with a
+   * valid element
+   * @return false otherwise
+   */
+  bool compileRow(const std::vector<std::string> &row,
+                  std::vector<int> &ids) const;
+
+  /**
+   * @brief Translates a row of a mapped file to element ids without copying
+   * its fields, see compileRow()
+   *
+   * @param row row of alternating category and element names
+   * @param ids vector the element ids are written to, indexed by category id
+   * @return true if the row contains every category exactly once with a
+   * valid element
+   * @return false otherwise
+   */
+  bool compileRow(const FIELDS &row, std::vector<int> &ids) const;
+
+  /**
+   * @brief Checks if a row is the header of a models file in the columnar
+   * format
+   * @note The header contains the name of every category exactly once, each
+   * following row contains one element per column
+   *
+   * @param row first row of the file
+   * @param columns receives the category id of each column, unchanged if
+   * the row is not a header
+   * @return true if the row is a header
+   * @return false otherwise
+   */
+  bool compileHeader(const std::vector<std::string> &row,
+                     std::vector<int> &columns) const;
+
+  /**
+   * @brief Checks if a row of a mapped file is a header, see compileHeader()
+   *
+   * @param row first row of the file
+   * @param columns receives the category id of each column
+   * @return true if the row is a header
+   * @return false otherwise
+   */
+  bool compileHeader(const FIELDS &row, std::vector<int> &columns) const;
+
+  /**
+   * @brief Translates a row of a columnar models file to element ids
+   * @note Each field is only looked up in the category of its column
+   *
+   * @param row one element name per column
+   * @param columns category id of each column, see compileHeader()
+   * @param ids vector the element ids are written to, indexed by category id
+   * @return true if every column contains a valid element
+   * @return false otherwise
+   */
+  bool compileColumns(const std::vector<std::string> &row,
+                      const std::vector<int> &columns,
+                      std::vector<int> &ids) const;
+
+  /**
+   * @brief Translates a row of a mapped columnar file to element ids, see
+   * compileColumns()
+   *
+   * @param row one element name per column
+   * @param columns category id of each column, see compileHeader()
+   * @param ids vector the element ids are written to, indexed by category id
+   * @return true if every column contains a valid element
+   * @return false otherwise
+   */
+  bool compileColumns(const FIELDS &row, const std::vector<int> &columns,
+                      std::vector<int> &ids) const;
+
+  /**
+   * @brief Turns a row of a columnar models file into alternating category
+   * and element names, as they are used in error messages
+   *
+   * @param row one element name per column
+   * @param columns category id of each column, see compileHeader()
+   * @param fields receives the names, pointing into row and the dictionary
+   */
+  void expandColumns(const std::vector<std::string> &row,
+                     const std::vector<int> &columns,
+                     std::vector<std::string_view> &fields) const;
+
+  /**
+   * @brief Turns a row of a mapped columnar file into alternating category
+   * and element names, see expandColumns()
+   *
+   * @param row one element name per column
+   * @param columns category id of each column, see compileHeader()
+   * @param fields receives the names, pointing into row and the dictionary
+   */
+  void expandColumns(const FIELDS &row, const std::vector<int> &columns,
+                     std::vector<std::string_view> &fields) const;
+
+private:
+  /**
+   * @brief Shared implementation of both compileRow() functions
+   *
+   * @tparam Row std::vector<std::string> or FIELDS
+   * @param row row of alternating category and element names
+   * @param ids vector the element ids are written to, indexed by category id
+   * @return true if the row could be translated
+   * @return false otherwise
+   */
+  template <typename Row>
+  bool compile(const Row &row, std::vector<int> &ids) const;
+
+  /**
+   * @brief Shared implementation of both compileHeader() functions
+   *
+   * @tparam Row std::vector<std::string> or FIELDS
+   * @param row first row of the file
+   * @param columns receives the category id of each column
+   * @return true if the row is a header
+   * @return false otherwise
+   */
+  template <typename Row>
+  bool header(const Row &row, std::vector<int> &columns) const;
+
+  /**
+   * @brief Shared implementation of both compileColumns() functions
+   *
+   * @tparam Row std::vector<std::string> or FIELDS
+   * @param row one element name per column
+   * @param columns category id of each column
+   * @param ids vector the element ids are written to, indexed by category id
+   * @return true if the row could be translated
+   * @return false otherwise
+   */
+  template <typename Row>
+  bool compileColumnRow(const Row &row, const std::vector<int> &columns,
+                        std::vector<int> &ids) const;
+
+  /**
+   * @brief Shared implementation of both expandColumns() functions
+   *
+   * @tparam Row std::vector<std::string> or FIELDS
+   * @param row one element name per column
+   * @param columns category id of each column
+   * @param fields receives the names
+   */
+  template <typename Row>
+  void expand(const Row &row, const std::vector<int> &columns,
+              std::vector<std::string_view> &fields) const;
+
+  /**
+   * @brief Names of the categories, indexed by category id
+   */
+  std::vector<std::string> m_categories;
+
+  /**
+   * @brief Names of the elements, indexed by category id and element id
+   */
+  std::vector<std::vector<std::string>> m_elements;
+
+  /**
+   * @brief Maps category names to their ids
+   */
+  std::unordered_map<std::string_view, int> m_categoryIds;
+
+  /**
+   * @brief Maps element names to their ids, one map per category
+   */
+  std::vector<std::unordered_map<std::string_view, int>> m_elementIds;
+
+  /**
+   * @brief Constraints as lists of (category, element) ids
+   */
+  std::vector<std::vector<std::pair<int, int>>> m_constraints;
+
+  /**
+   * @brief Ids of the constraints containing each element, indexed by category
+   * id and element id
+   */
+  std::vector<std::vector<std::vector<int>>> m_constraintIndex;
+
+  /**
+   * @brief Ids of the constraints starting with each element, indexed by
+   * category id and element id
+   */
+  std::vector<std::vector<std::vector<int>>> m_firstEntryIndex;
+
+  /**
+   * @brief Rows of the constraints file written as expressions
+   */
+  std::vector<EXPRESSION> m_rules;
+
+  /**
+   * @brief Ids of the expressions testing each category, indexed by category
+   * id
+   */
+  std::vector<std::vector<int>> m_ruleIndex;
+};
+
+#endif
@@ -0,0 +1,332 @@
+/**
+ * @file expression.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for EXPRESSION class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "expression.hpp"
+#include "dictionary.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+// Initialize the static member variables outside the class definition
+const int EXPRESSION::maxDepth = 64;
+
+EXPRESSION::EXPRESSION() : m_next(0) {}
+
+EXPRESSION::~EXPRESSION() {}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+bool EXPRESSION::isExpression(const std::vector<std::string> &row) {
+  return !row.empty() && !row[0].empty() && row[0][0] == '@';
+}
+
+std::string EXPRESSION::join(const std::vector<std::string> &row) {
+  std::string text;
+  for (std::size_t i = 0; i < row.size(); i++) {
+    if (i) {
+      text += ',';
+    }
+    text += row[i];
+  }
+  return text.substr(1);
+}
+
+int EXPRESSION::compile(const std::string &text, const DICTIONARY &d,
+                        std::string &error) {
+  m_program.clear();
+  m_masks.clear();
+  m_categories.clear();
+  m_next = 0;
+
+  if (!tokenize(text, error)) {
+    return 30;
+  }
+  if (m_tokens.empty()) {
+    error = "Expression is empty";
+    return 30;
+  }
+  bool valid = parseImplies(d, error, 0);
+  if (valid && m_next < m_tokens.size()) {
+    error = "Unexpected '" + m_tokens[m_next].text + "'" + where();
+    valid = false;
+  }
+  m_tokens.clear();
+  if (!valid) {
+    return 30;
+  }
+
+  // The stack of evaluate() has a fixed size, every test pushes a value and
+  // every operator but 'not' takes one away
+  int height = 0;
+  for (const INSTRUCTION &instruction : m_program) {
+    if (instruction.opcode == TEST) {
+      height++;
+    } else if (instruction.opcode != NOT) {
+      height--;
+    }
+    if (height > maxDepth) {
+      error = "Expression is nested too deeply";
+      return 30;
+    }
+  }
+
+  std::sort(m_categories.begin(), m_categories.end());
+  m_categories.erase(std::unique(m_categories.begin(), m_categories.end()),
+                     m_categories.end());
+  return 0;
+}
+
+EXPRESSION::VALUE EXPRESSION::evaluate(const std::vector<int> &row,
+                                       int category, int element) const {
+  VALUE stack[maxDepth];
+  int top = -1;
+  for (const INSTRUCTION &instruction : m_program) {
+    switch (instruction.opcode) {
+    case TEST: {
+      int e = instruction.category == category ? element
+                                               : row[instruction.category];
+      if (e < 0) {
+        stack[++top] = UNKNOWN;
+      } else {
+        std::uint64_t word = m_masks[instruction.mask + e / 64];
+        stack[++top] = (word >> (e % 64)) & 1 ? TRUE : FALSE;
+      }
+      break;
+    }
+    case NOT:
+      stack[top] = VALUE(TRUE - stack[top]);
+      break;
+    case AND:
+      top--;
+      stack[top] = std::min(stack[top], stack[top + 1]);
+      break;
+    case OR:
+      top--;
+      stack[top] = std::max(stack[top], stack[top + 1]);
+      break;
+    case IMPLIES:
+      top--;
+      stack[top] = std::max(VALUE(TRUE - stack[top]), stack[top + 1]);
+      break;
+    }
+  }
+  return stack[0];
+}
+
+const std::vector<int> &EXPRESSION::getCategories() const {
+  return m_categories;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper Functions                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+bool EXPRESSION::tokenize(const std::string &text, std::string &error) {
+  m_tokens.clear();
+  std::size_t i = 0;
+  while (i < text.size()) {
+    unsigned char c = text[i];
+    if (std::isspace(c)) {
+      i++;
+      continue;
+    }
+
+    // Operators and parentheses
+    if (text.compare(i, 2, "=>") == 0 || text.compare(i, 2, "!=") == 0) {
+      m_tokens.push_back({text.substr(i, 2), false, i});
+      i += 2;
+      continue;
+    }
+    if (std::strchr("(),=", c)) {
+      m_tokens.push_back({text.substr(i, 1), false, i});
+      i++;
+      continue;
+    }
+
+    // Quoted names may contain anything but a quote
+    if (c == '\'') {
+      std::size_t end = text.find('\'', i + 1);
+      if (end == std::string::npos) {
+        error = "Missing closing quote for the name at position " +
+                std::to_string(i + 1);
+        return false;
+      }
+      m_tokens.push_back({text.substr(i + 1, end - i - 1), true, i});
+      i = end + 1;
+      continue;
+    }
+
+    // Plain names end at whitespace or at an operator
+    std::size_t begin = i;
+    while (i < text.size() && !std::isspace((unsigned char)text[i]) &&
+           !std::strchr("()!,='", text[i])) {
+      i++;
+    }
+    if (i == begin) {
+      error = std::string("Unexpected character '") + text[i] +
+              "' at position " + std::to_string(i + 1);
+      return false;
+    }
+    std::string name = text.substr(begin, i - begin);
+    bool keyword =
+        name == "and" || name == "or" || name == "not" || name == "in";
+    m_tokens.push_back({name, !keyword, begin});
+  }
+  return true;
+}
+
+bool EXPRESSION::accept(const char *text) {
+  if (m_next < m_tokens.size() && !m_tokens[m_next].name &&
+      m_tokens[m_next].text == text) {
+    m_next++;
+    return true;
+  }
+  return false;
+}
+
+bool EXPRESSION::parseImplies(const DICTIONARY &d, std::string &error,
+                              int depth) {
+  if (depth > maxDepth) {
+    error = "Expression is nested too deeply";
+    return false;
+  }
+  if (!parseOr(d, error, depth)) {
+    return false;
+  }
+  if (accept("=>")) {
+    if (!parseImplies(d, error, depth + 1)) {
+      return false;
+    }
+    m_program.push_back({IMPLIES, -1, 0});
+  }
+  return true;
+}
+
+bool EXPRESSION::parseOr(const DICTIONARY &d, std::string &error, int depth) {
+  if (!parseAnd(d, error, depth)) {
+    return false;
+  }
+  while (accept("or")) {
+    if (!parseAnd(d, error, depth)) {
+      return false;
+    }
+    m_program.push_back({OR, -1, 0});
+  }
+  return true;
+}
+
+bool EXPRESSION::parseAnd(const DICTIONARY &d, std::string &error,
+                          int depth) {
+  if (!parseUnary(d, error, depth)) {
+    return false;
+  }
+  while (accept("and")) {
+    if (!parseUnary(d, error, depth)) {
+      return false;
+    }
+    m_program.push_back({AND, -1, 0});
+  }
+  return true;
+}
+
+bool EXPRESSION::parseUnary(const DICTIONARY &d, std::string &error,
+                            int depth) {
+  if (depth > maxDepth) {
+    error = "Expression is nested too deeply";
+    return false;
+  }
+  if (accept("not")) {
+    if (!parseUnary(d, error, depth + 1)) {
+      return false;
+    }
+    m_program.push_back({NOT, -1, 0});
+    return true;
+  }
+  if (accept("(")) {
+    if (!parseImplies(d, error, depth + 1)) {
+      return false;
+    }
+    if (!accept(")")) {
+      error = "Missing ')'" + where();
+      return false;
+    }
+    return true;
+  }
+  return parseTest(d, error);
+}
+
+bool EXPRESSION::parseTest(const DICTIONARY &d, std::string &error) {
+  if (m_next >= m_tokens.size() || !m_tokens[m_next].name) {
+    error = "Expected a category name" + where();
+    return false;
+  }
+  const TOKEN &name = m_tokens[m_next++];
+  int category = d.findCategory(name.text);
+  if (category < 0) {
+    error = "Invalid category name '" + name.text + "' at position " +
+            std::to_string(name.position + 1);
+    return false;
+  }
+
+  bool negated = false;
+  bool list = false;
+  if (accept("!=")) {
+    negated = true;
+  } else if (accept("in")) {
+    list = true;
+    if (!accept("(")) {
+      error = "Expected '(' after 'in'" + where();
+      return false;
+    }
+  } else if (!accept("=")) {
+    error = "Expected '=', '!=' or 'in' after category " + name.text + where();
+    return false;
+  }
+
+  // Set the bit of every listed element
+  std::size_t mask = m_masks.size();
+  m_masks.resize(mask + (d.getElementCount(category) + 63) / 64, 0);
+  do {
+    if (m_next >= m_tokens.size() || !m_tokens[m_next].name) {
+      error = "Expected an element name" + where();
+      return false;
+    }
+    const TOKEN &value = m_tokens[m_next++];
+    int element = d.findElement(category, value.text);
+    if (element < 0) {
+      error = "Invalid element '" + value.text + "' of category " +
+              name.text + " at position " + std::to_string(value.position + 1);
+      return false;
+    }
+    m_masks[mask + element / 64] |= std::uint64_t(1) << (element % 64);
+  } while (list && accept(","));
+  if (list && !accept(")")) {
+    error = "Missing ')'" + where();
+    return false;
+  }
+
+  m_program.push_back({TEST, category, mask});
+  if (negated) {
+    m_program.push_back({NOT, -1, 0});
+  }
+  m_categories.push_back(category);
+  return true;
+}
+
+std::string EXPRESSION::where() const {
+  if (m_next >= m_tokens.size()) {
+    return " at the end of the expression";
+  }
+  return " at position " + std::to_string(m_tokens[m_next].position + 1);
+}
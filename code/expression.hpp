@@ -0,0 +1,225 @@
+/**
+ * @file expression.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for EXPRESSION class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_EXPRESSION
+#define PAIRWISE_EXPRESSION
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Forward declaration
+class DICTIONARY;
+
+/**
+ * @brief A rule of the constraints file written as an expression, compiled to
+ * a small stack program that is evaluated against rows of element ids
+ * @note A row of the constraints file is an expression if its first field
+ * starts with '@'. Unlike the other rows, which list a combination that must
+ * not appear, an expression states a condition every row has to fulfill:
+ *
+ *     @ Prozessor=AMD => not (RAM in (7, 8) and Bildschirm=8)
+ *
+ * Operators from lowest to highest precedence are '=>', 'or', 'and' and
+ * 'not', parentheses group. Tests are 'Category=Element',
+ * 'Category!=Element' and 'Category in (Element, Element, ...)'. Names
+ * containing spaces or operators are written in single quotes. The row
+ * 'A,a,B,b' has the same meaning as '@ not (A=a and B=b)'.
+ *
+ * Each test is compiled to a bitmask over the elements of its category, so
+ * evaluating a row never compares any names.
+ */
+class EXPRESSION {
+public:
+  /**
+   * @brief Result of evaluating an expression against a row
+   * @note Rows may be partial, an expression that depends on unassigned
+   * categories evaluates to UNKNOWN. Results are ordered so that 'and' is the
+   * minimum and 'or' the maximum of its operands.
+   */
+  enum VALUE : std::uint8_t { FALSE = 0, UNKNOWN = 1, TRUE = 2 };
+
+  /**
+   * @brief Maximum depth of nested operands
+   */
+  static const int maxDepth;
+
+  EXPRESSION();
+  ~EXPRESSION();
+
+  /**
+   * @brief Checks if a row of the constraints file is an expression
+   *
+   * @param row fields of the row
+   * @return true if the first field starts with '@'
+   * @return false otherwise
+   */
+  static bool isExpression(const std::vector<std::string> &row);
+
+  /**
+   * @brief Recovers the text of an expression that was split into fields at
+   * its commas
+   *
+   * @param row fields of the row
+   * @return std::string text of the expression without the leading '@'
+   */
+  static std::string join(const std::vector<std::string> &row);
+
+  /**
+   * @brief Compiles an expression
+   *
+   * @param text text of the expression
+   * @param d dictionary containing the names of the options
+   * @param error receives a description of the problem if the expression is
+   * invalid
+   * @return int status code (see documentation), 30 if the expression is
+   * invalid
+   */
+  int compile(const std::string &text, const DICTIONARY &d,
+              std::string &error);
+
+  /**
+   * @brief Evaluates the expression against a row
+   *
+   * @param row element ids indexed by category id, -1 for unassigned
+   * categories
+   * @param category if not -1, this category is treated as assigned to
+   * element regardless of row
+   * @param element element id used for category
+   * @return VALUE FALSE if the row violates the expression
+   */
+  VALUE evaluate(const std::vector<int> &row, int category = -1,
+                 int element = -1) const;
+
+  /**
+   * @brief Get the categories tested by the expression
+   *
+   * @return const std::vector<int>& sorted ids of the categories
+   */
+  const std::vector<int> &getCategories() const;
+
+private:
+  /**
+   * @brief Instructions of the stack program
+   */
+  enum OPCODE : std::uint8_t { TEST, NOT, AND, OR, IMPLIES };
+
+  /**
+   * @brief One instruction, TEST pushes whether the element of category is
+   * in the bitmask starting at mask
+   */
+  struct INSTRUCTION {
+    OPCODE opcode;
+    int category;
+    std::size_t mask;
+  };
+
+  /**
+   * @brief Token of the expression text
+   */
+  struct TOKEN {
+    /**
+     * @brief Text of the token, without quotes for quoted names
+     */
+    std::string text;
+
+    /**
+     * @brief True if the token is a name, false for operators and
+     * parentheses
+     */
+    bool name;
+
+    /**
+     * @brief Position of the token in the text, used for error messages
+     */
+    std::size_t position;
+  };
+
+  /**
+   * @brief Splits the text into tokens
+   *
+   * @param text text of the expression
+   * @param error receives a description of the problem
+   * @return true if the text could be split
+   * @return false otherwise
+   */
+  bool tokenize(const std::string &text, std::string &error);
+
+  /**
+   * @brief Checks if the next token is a certain operator or keyword and
+   * skips it if so
+   *
+   * @param text operator or keyword
+   * @return true if the token was skipped
+   * @return false otherwise
+   */
+  bool accept(const char *text);
+
+  /**
+   * @brief Compiles an implication, the right side may be an implication
+   * itself
+   */
+  bool parseImplies(const DICTIONARY &d, std::string &error, int depth);
+
+  /**
+   * @brief Compiles operands joined by 'or'
+   */
+  bool parseOr(const DICTIONARY &d, std::string &error, int depth);
+
+  /**
+   * @brief Compiles operands joined by 'and'
+   */
+  bool parseAnd(const DICTIONARY &d, std::string &error, int depth);
+
+  /**
+   * @brief Compiles a negation, a test or an expression in parentheses
+   */
+  bool parseUnary(const DICTIONARY &d, std::string &error, int depth);
+
+  /**
+   * @brief Compiles a test of a category
+   */
+  bool parseTest(const DICTIONARY &d, std::string &error);
+
+  /**
+   * @brief Describes the position of the next token for error messages
+   *
+   * @return std::string description
+   */
+  std::string where() const;
+
+  /**
+   * @brief Compiled program
+   */
+  std::vector<INSTRUCTION> m_program;
+
+  /**
+   * @brief Bitmasks of all tests, 64 elements per word
+   */
+  std::vector<std::uint64_t> m_masks;
+
+  /**
+   * @brief Categories tested by the program
+   */
+  std::vector<int> m_categories;
+
+  /**
+   * @brief Tokens while compiling, empty afterwards
+   */
+  std::vector<TOKEN> m_tokens;
+
+  /**
+   * @brief Position of the next token while compiling
+   */
+  std::size_t m_next;
+};
+
+#endif
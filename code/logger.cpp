@@ -4,13 +4,40 @@
  * @brief Contains initalisation for LOGGER class
  * @version 1.0
  * @date 25-07-2023
- * 
+ *
  * @copyright Copyright (c) 2023
- * 
+ *
  */
 
 
 #include "logger.hpp"
 
+#include <cstdlib>
+
 // Initialize the static member variable outside the class definition
-bool LOGGER::verboseMode = false;
\ No newline at end of file
+LOGGER::LEVEL LOGGER::level = LOGGER::WARNING;
+
+bool LOGGER::setLevel(const std::string &name) {
+    if (name == "trace") {
+        level = TRACE;
+    } else if (name == "debug") {
+        level = DEBUG;
+    } else if (name == "info") {
+        level = INFO;
+    } else if (name == "warning") {
+        level = WARNING;
+    } else if (name == "off") {
+        level = OFF;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void LOGGER::configure() {
+    const char *name = std::getenv("PAIRWISE_LOG");
+    if (name && !setLevel(name)) {
+        std::cerr << "Unknown log level in PAIRWISE_LOG: " << name
+                  << std::endl;
+    }
+}
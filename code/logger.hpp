@@ -4,46 +4,159 @@
  * @brief Contains LOGGER class
  * @version 1.0
  * @date 25-07-2023
- * 
+ *
  * @copyright Copyright (c) 2023
- * 
+ *
  */
 
 #ifndef PAIRWISE_LOGGER
 #define PAIRWISE_LOGGER
 
 #include <iostream>
+#include <sstream>
 #include <string>
 
 /**
- * @brief only prints Status Messages if Verbose Mode is enabled
+ * @brief Lowest level that is compiled in, messages below it are removed by
+ * the compiler (0 = trace, 1 = debug, 2 = info, 3 = warning). Build with
+ * "make LOG_LEVEL=0" to keep trace messages.
+ */
+#ifndef PAIRWISE_LOG_LEVEL
+#define PAIRWISE_LOG_LEVEL 2
+#endif
+
+/**
+ * @brief Logs a message at a level, e.g. LOGGER_AT(LOGGER::INFO) << "text".
+ * The message is only evaluated if the level is enabled, so messages may be
+ * expensive to build.
+ */
+#define LOGGER_AT(level)                                                       \
+    if ((level) < PAIRWISE_LOG_LEVEL || !LOGGER::isEnabled(level)) {           \
+    } else                                                                     \
+        LOGGER(level)
+
+/**
+ * @brief Detailed messages from inside loops, removed from normal builds
+ */
+#define LOGGER_TRACE LOGGER_AT(LOGGER::TRACE)
+
+/**
+ * @brief Messages about intermediate results, removed from normal builds
+ */
+#define LOGGER_DEBUG LOGGER_AT(LOGGER::DEBUG)
+
+/**
+ * @brief Status messages printed in verbose mode
+ */
+#define LOGGER_INFO LOGGER_AT(LOGGER::INFO)
+
+/**
+ * @brief Problems that do not stop the program, printed to std::cerr unless
+ * logging is turned off
+ */
+#define LOGGER_WARNING LOGGER_AT(LOGGER::WARNING)
+
+/**
+ * @brief only prints Status Messages if their level is enabled
+ * @note Use the LOGGER_TRACE, LOGGER_DEBUG and LOGGER_INFO macros instead of
+ * creating a LOGGER directly, they skip building disabled messages. Each
+ * message is collected and printed at once, so messages from several threads
+ * do not mix.
  */
 class LOGGER {
+public:
+    /**
+     * @brief Levels of messages, OFF disables all of them
+     */
+    enum LEVEL { TRACE = 0, DEBUG = 1, INFO = 2, WARNING = 3, OFF = 4 };
+
 private:
     /**
-     * @brief If true, status messages will be logged to the console
+     * @brief Lowest level that is printed, set at runtime
+     */
+    static LEVEL level;
+
+    /**
+     * @brief True if the level of this message is printed
      */
-    static bool verboseMode;
+    bool m_enabled;
+
+    /**
+     * @brief True if this message is a warning
+     */
+    bool m_warning;
+
+    /**
+     * @brief Collects the message until it is printed
+     */
+    std::ostringstream m_message;
 
 public:
+    /**
+     * @brief Starts a message
+     *
+     * @param messageLevel level of the message
+     */
+    LOGGER(LEVEL messageLevel = INFO)
+        : m_enabled(isEnabled(messageLevel)),
+          m_warning(messageLevel == WARNING) {}
+
+    /**
+     * @brief Prints the collected message, warnings go to std::cerr
+     */
+    ~LOGGER() {
+        if (m_enabled) {
+            (m_warning ? std::cerr : std::cout) << m_message.str() << std::flush;
+        }
+    }
+
     /**
      * @brief Set the Verbose Mode object
-     * 
-     * @param verbose set to true to enable output of status messages
+     *
+     * @param verbose set to true to enable output of status messages,
+     * warnings are printed either way
      */
     static void SetVerboseMode(bool verbose) {
-        verboseMode = verbose;
+        level = verbose ? INFO : WARNING;
+    }
+
+    /**
+     * @brief Sets the lowest level that is printed
+     * @note Levels below PAIRWISE_LOG_LEVEL are never printed
+     *
+     * @param name "trace", "debug", "info", "warning" or "off"
+     * @return true if the name is a level
+     * @return false otherwise, the level is unchanged
+     */
+    static bool setLevel(const std::string &name);
+
+    /**
+     * @brief Sets the level from the environment variable PAIRWISE_LOG,
+     * which holds the name of a level (see setLevel())
+     */
+    static void configure();
+
+    /**
+     * @brief Checks if messages of a level are printed
+     *
+     * @param messageLevel level of the message
+     * @return true if the message is printed
+     * @return false otherwise
+     */
+    static bool isEnabled(LEVEL messageLevel) {
+        return messageLevel >= PAIRWISE_LOG_LEVEL && messageLevel >= level &&
+               messageLevel != OFF;
     }
 
     template <typename T>
     /**
      * @brief Replaces std::cout, only prints if logging is enabled
-     * 
+     *
      * @param message message to be printed (just replace std::cout with LOGGER::cout)
      */
     LOGGER& operator<<(const T& message) {
-        if (verboseMode) {
-            std::cout << message;
+        if (m_enabled) {
+            m_message << message;
         }
         return *this;
     }
@@ -51,8 +164,8 @@ public:
     // Support for manipulators like std::endl
     typedef std::ostream& (*Manipulator)(std::ostream&);
     LOGGER& operator<<(Manipulator manip) {
-        if (verboseMode) {
-            std::cout << manip;
+        if (m_enabled) {
+            m_message << manip;
         }
         return *this;
     }
@@ -0,0 +1,62 @@
+/**
+ * @file memory.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for MEMORY and MEMORYSTREAM classes
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "memory.hpp"
+
+#include <utility>
+
+// Initialize the static member variables outside the class definition
+const std::string MEMORY::prefix = "mem:";
+std::map<std::string, std::string> MEMORY::files;
+std::mutex MEMORY::lock;
+
+MEMORYSTREAM::MEMORYSTREAM(const std::string &filename)
+    : std::ostream(nullptr), m_filename(filename) {
+  rdbuf(&m_buffer);
+}
+
+MEMORYSTREAM::~MEMORYSTREAM() {}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+bool MEMORY::isMemory(const std::string &filename) {
+  return filename.compare(0, prefix.size(), prefix) == 0;
+}
+
+void MEMORY::write(const std::string &filename, std::string data) {
+  std::lock_guard<std::mutex> guard(lock);
+  files[filename] = std::move(data);
+}
+
+bool MEMORY::read(const std::string &filename, std::string &data) {
+  std::lock_guard<std::mutex> guard(lock);
+  auto file = files.find(filename);
+  if (file == files.end()) {
+    return false;
+  }
+  data = file->second;
+  return true;
+}
+
+void MEMORY::remove(const std::string &filename) {
+  std::lock_guard<std::mutex> guard(lock);
+  files.erase(filename);
+}
+
+bool MEMORYSTREAM::finish() {
+  if (!*this) {
+    return false;
+  }
+  MEMORY::write(m_filename, m_buffer.str());
+  return true;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file memory.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for MEMORY and MEMORYSTREAM classes
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_MEMORY
+#define PAIRWISE_MEMORY
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @brief Files kept in memory instead of on disk
+ * @note Every filename starting with "mem:" names a memory file. They can be
+ * used wherever a filename is expected, PARSER reads them and PRETTYPRINT
+ * writes them, so that tests and embedding programs do not need the file
+ * system.
+ */
+class MEMORY {
+public:
+  /**
+   * @brief Prefix of the names of memory files
+   */
+  static const std::string prefix;
+
+  /**
+   * @brief Checks if a filename names a memory file
+   *
+   * @param filename filename to be checked
+   * @return true if it starts with the prefix
+   * @return false otherwise
+   */
+  static bool isMemory(const std::string &filename);
+
+  /**
+   * @brief Creates or replaces a memory file
+   *
+   * @param filename name of the memory file
+   * @param data contents of the file
+   */
+  static void write(const std::string &filename, std::string data);
+
+  /**
+   * @brief Gets the contents of a memory file
+   *
+   * @param filename name of the memory file
+   * @param data receives the contents of the file
+   * @return true if the file exists
+   * @return false otherwise
+   */
+  static bool read(const std::string &filename, std::string &data);
+
+  /**
+   * @brief Removes a memory file
+   *
+   * @param filename name of the memory file
+   */
+  static void remove(const std::string &filename);
+
+private:
+  /**
+   * @brief Contents of all memory files by name
+   */
+  static std::map<std::string, std::string> files;
+
+  /**
+   * @brief Guards #files, readers and writers may run on different threads
+   */
+  static std::mutex lock;
+};
+
+/**
+ * @brief Output stream collecting the contents of a memory file
+ * @note Like WRITER, the memory file is only replaced when finish() is
+ * called.
+ */
+class MEMORYSTREAM : public std::ostream {
+public:
+  /**
+   * @brief Creates an empty stream for a memory file
+   *
+   * @param filename name of the memory file
+   */
+  explicit MEMORYSTREAM(const std::string &filename);
+  ~MEMORYSTREAM();
+
+  /**
+   * @brief Replaces the memory file with the written data
+   *
+   * @return true if all data was written
+   * @return false otherwise, the memory file is left unchanged
+   */
+  bool finish();
+
+private:
+  /**
+   * @brief Name of the memory file
+   */
+  std::string m_filename;
+
+  /**
+   * @brief Buffer collecting the data
+   */
+  std::stringbuf m_buffer;
+};
+
+#endif
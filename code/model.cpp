@@ -11,10 +11,14 @@
 
 #include "model.hpp"
 #include "checker.hpp"
+#include "dictionary.hpp"
 #include "parser.hpp"
+#include "pipeline.hpp"
 #include "prettyPrint.hpp"
 #include "solver.hpp"
 
+#include <utility>
+
 MODEL::MODEL() { m_problem = nullptr; }
 
 MODEL::MODEL(PROBLEM *p, std::string filename) {
@@ -49,8 +53,70 @@ int MODEL::solve() {
 
 }
 
+int MODEL::stream() {
+  // Open output file, "-" means the rows are written to stdout. Other
+  // programs may read the rows while they are written.
+  std::unique_ptr<std::ostream> file =
+      PRETTYPRINT::openSink(m_modelsFileName, true);
+  if (!file) {
+    std::cout << "Error opening file: " << m_modelsFileName << std::endl;
+    return 10;
+  }
+  std::ostream *out = file.get();
+
+  // Run solver and write out every row right away, with the categories in
+  // the order of the options like the rows of solve()
+  m_models.clear();
+  DICTIONARY d;
+  bool sorted = d.build(m_problem) == 0;
+  int solveStatus = SOLVER::generate(
+      m_problem, [this, out, &d, sorted](std::vector<std::string> row) {
+        if (sorted) {
+          PRETTYPRINT::sortRow(d, row);
+        }
+        PRETTYPRINT::printRow(*out, row);
+        out->flush();
+        if (!*out) {
+          return 10;
+        }
+        m_models.push_back(std::move(row));
+        return 0;
+      });
+  if (solveStatus) {
+    return solveStatus;
+  }
+  // Compressed files are only complete once they are closed
+  if (!PRETTYPRINT::closeSink(file)) {
+    std::cout << "Error writing file: " << m_modelsFileName << std::endl;
+    return 10;
+  }
+
+  // Check the complete model, messages go to stderr as stdout may contain
+  // the model
+  int checkStatus = check();
+  if (checkStatus == 100) {
+    return 0;
+  } else if (checkStatus) {
+    std::cerr << "\033[1;31mERROR: VERIFICATION FAILED\033[0m\n";
+    return checkStatus;
+  }
+
+  return 0;
+}
+
+int MODEL::pipeline() {
+  m_models.clear();
+  int status = PIPELINE::run(this);
+  // Messages go to stderr as stdout may contain the model
+  if (status == 40) {
+    std::cerr << "\033[1;31mERROR: VERIFICATION FAILED\033[0m\n";
+  }
+  return status;
+}
+
 void MODEL::setModel(std::vector<std::vector<std::string>> model) {
-  m_models = model;
+  m_models = std::move(model);
+  m_table.reset();
 }
 
 int MODEL::parse() {
@@ -58,8 +124,23 @@ int MODEL::parse() {
   return status;
 }
 
-int MODEL::check() {
-  int status = CHECKER::check(this, m_problem);
+int MODEL::map() {
+  int status = PARSER::mapModel(this);
+  return status;
+}
+
+int MODEL::check(int strength) {
+  int status = CHECKER::check(this, m_problem, strength);
+  return status;
+}
+
+int MODEL::checkStream(int strength) {
+  int status = CHECKER::checkStream(this, m_problem, strength);
+  return status;
+}
+
+int MODEL::checkIncremental(int strength) {
+  int status = CHECKER::checkIncremental(this, m_problem, strength);
   return status;
 }
 
@@ -68,10 +149,19 @@ int MODEL::print() {
   return status;
 }
 
+void MODEL::setTable(std::shared_ptr<const TABLE> table) {
+  m_models.clear();
+  m_table = table;
+}
+
+const TABLE *MODEL::getTable() const { return m_table.get(); }
+
 void MODEL::setModelsFile(std::string filename) { m_modelsFileName = filename; }
 
 std::string MODEL::getModelsFile() const { return m_modelsFileName; }
 
-std::vector<std::vector<std::string>> MODEL::getModels() const {
+PROBLEM *MODEL::getProblem() const { return m_problem; }
+
+const std::vector<std::vector<std::string>> &MODEL::getModels() const {
   return m_models;
 }
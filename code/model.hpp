@@ -12,7 +12,9 @@
 #define PAIRWISE_MODEL
 
 #include "problem.hpp"
+#include "table.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -43,12 +45,54 @@ public:
    */
   int solve();
 
+  /**
+   * @brief Solves the model and writes each row to the .models file as soon as
+   * it is generated, the complete model is checked afterwards
+   * @note If #m_modelsFileName is "-" the rows are written to stdout instead
+   *
+   * @return int status code (see documentation)
+   */
+  int stream();
+
+  /**
+   * @brief Solves the model while checking and writing the rows on separate
+   * threads, see PIPELINE
+   * @note The rows are not stored in #m_models. If #m_modelsFileName is "-"
+   * the rows are written to stdout instead.
+   *
+   * @return int status code (see documentation)
+   */
+  int pipeline();
+
   /**
    * @brief Checks the current model
    *
+   * @param strength number of categories per combination that has to be
+   * covered, default = 2 (pairwise)
+   * @return int status code  (see documentation)
+   */
+  int check(int strength = 2);
+
+  /**
+   * @brief Checks the .models file while reading it, without storing the rows
+   * in #m_models
+   * @note Uses filename stored in #m_modelsFileName as source, "-" for stdin
+   *
+   * @param strength number of categories per combination that has to be
+   * covered, default = 2 (pairwise)
+   * @return int status code  (see documentation)
+   */
+  int checkStream(int strength = 2);
+
+  /**
+   * @brief Checks only the rows appended to the .models file since the last
+   * check, using a checkpoint file next to it (see CHECKER::checkIncremental())
+   *
+   * @param strength number of categories per combination that has to be
+   * covered, default = 2 (pairwise)
    * @return int status code  (see documentation)
    */
-  int check();
+  int checkIncremental(int strength = 2);
 
   /**
    * @brief outputs the current model to a .models file
@@ -67,12 +111,29 @@ public:
    */
   int parse();
 
+  /**
+   * @brief parses an existing solution by mapping the .models file into
+   * memory, the rows are not copied to #m_models
+   * @note uses filename stored in #m_modelsFileName as source. The mapping is
+   * kept until the model is destroyed or setModel() is called.
+   *
+   * @return int status code (see documentation)
+   */
+  int map();
+
   /**
    * @brief Store the given models in this class (#m_models)
    * @param models two-dimenstional vector contaitning models
    */
   void setModel(std::vector<std::vector<std::string>> models);
 
+  /**
+   * @brief Store a mapped .models file in this class (#m_table)
+   *
+   * @param table table containing the rows of the mapped file
+   */
+  void setTable(std::shared_ptr<const TABLE> table);
+
   /**
    * @brief Set the #m_modelsFileName
    * @note used for parsing or printing depending on usecase
@@ -82,10 +143,18 @@ public:
 
   /**
    * @brief Get the #m_models vector
+   * @note Empty if the model was parsed with map(), see getTable()
+   *
+   * @return const std::vector<std::vector<std::string>>& reference to models
+   */
+  const std::vector<std::vector<std::string>> &getModels() const;
+
+  /**
+   * @brief Get the #m_table
    *
-   * @return std::vector<std::vector<std::string>> models
+   * @return const TABLE* mapped rows, nullptr if the model was not mapped
    */
-  std::vector<std::vector<std::string>> getModels() const;
+  const TABLE *getTable() const;
 
   /**
    * @brief Get the #m_modelsFileName name
@@ -94,6 +163,13 @@ public:
    */
   std::string getModelsFile() const;
 
+  /**
+   * @brief Get the problem the model belongs to
+   *
+   * @return PROBLEM* problem passed to the constructor
+   */
+  PROBLEM *getProblem() const;
+
 private:
   /**
    * @brief Reference to instance of PROBLEM class used to create the solution
@@ -105,6 +181,12 @@ private:
    */
   std::vector<std::vector<std::string>> m_models;
 
+  /**
+   * @brief Rows of the mapped .models file, used instead of #m_models if the
+   * model was parsed with map()
+   */
+  std::shared_ptr<const TABLE> m_table;
+
   /**
    * @brief stores the filename for the .models file
    * @note used for parsing or printing depending on usecase
@@ -0,0 +1,57 @@
+/**
+ * @file parallel.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for PARALLEL class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Initialize the static member variable outside the class definition
+unsigned PARALLEL::threads = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+void PARALLEL::setThreads(unsigned count) { threads = count; }
+
+unsigned PARALLEL::getThreads() {
+  if (threads) {
+    return threads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+unsigned
+PARALLEL::run(std::size_t count, std::size_t minimum,
+              const std::function<void(unsigned, std::size_t, std::size_t)> &task) {
+  // Use fewer chunks if there is not enough work for every thread
+  std::size_t chunks = getThreads();
+  if (minimum > 0) {
+    chunks = std::min(chunks, std::max<std::size_t>(1, count / minimum));
+  }
+
+  // Start a worker for every chunk but the first
+  std::vector<std::thread> workers;
+  for (std::size_t i = 1; i < chunks; i++) {
+    workers.emplace_back(task, i, count * i / chunks,
+                         count * (i + 1) / chunks);
+  }
+
+  // First chunk runs on this thread
+  task(0, 0, count / chunks);
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return chunks;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file parallel.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for PARALLEL class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_PARALLEL
+#define PAIRWISE_PARALLEL
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Splits work into contiguous chunks and runs them on several threads
+ */
+class PARALLEL {
+private:
+  /**
+   * @brief Number of threads used, 0 means one per available core
+   */
+  static unsigned threads;
+
+public:
+  /**
+   * @brief Set the number of threads
+   *
+   * @param count number of threads to be used, 0 = one per available core
+   */
+  static void setThreads(unsigned count);
+
+  /**
+   * @brief Get the number of threads that will be used
+   *
+   * @return unsigned number of threads
+   */
+  static unsigned getThreads();
+
+  /**
+   * @brief Splits the range [0, count) into one contiguous chunk per thread
+   * and runs the task on each chunk
+   * @note Chunks are numbered in the order of their position in the range,
+   * chunk 0 runs on the calling thread. Returns once all chunks are done.
+   *
+   * @param count size of the range
+   * @param minimum minimum number of entries per chunk, smaller ranges use
+   * fewer threads
+   * @param task function receiving the chunk number and the range of the
+   * chunk [begin, end)
+   * @return unsigned number of chunks the range was split into
+   */
+  static unsigned
+  run(std::size_t count, std::size_t minimum,
+      const std::function<void(unsigned, std::size_t, std::size_t)> &task);
+};
+
+#endif
@@ -8,8 +8,12 @@
  * @copyright Copyright (c) 2023
  */
 
+#include "model.hpp"
+#include "parser.hpp"
+#include "prettyPrint.hpp"
 #include "problem.hpp"
 #include <iostream>
+#include <string>
 #include "logger.hpp"
 
 /**
@@ -21,11 +25,51 @@
  * @arg \c constraintsFileIn Filename for .constraints input file
  * @arg \c optionsFileOut Filename for .options output file
  * @arg \c constraintsFileOut Filename for .constraints output file
+ *
+ * Alternatively converts a .models file between csv, the columnar csv
+ * format with a header row and the binary format (see BINARY), the input may
+ * be in any of them:
+ * @arg \c --binary, \c --columns or \c --csv format of the output file
+ * @arg \c optionsFile Filename for .options file, the binary header is built
+ * from it
+ * @arg \c modelsFileIn Filename for .models input file
+ * @arg \c modelsFileOut Filename for .models output file
+ *
+ * Any input file may be "-" to read from stdin and any output file may be
+ * "-" to write to stdout.
  * @return \c int status code (see documentation)
  */
 int main(int argc, char **argv) {
-  //Set this to true to enable verbose logging to console
-  LOGGER::SetVerboseMode(false);
+  // Only warnings are printed unless PAIRWISE_LOG names a level
+  LOGGER::configure();
+
+  // Convert models file
+  std::string format = argc > 1 ? argv[1] : "";
+  if ((format == "--binary" || format == "--columns" || format == "--csv") &&
+      argc == 5) {
+    PROBLEM problem = PROBLEM(argv[2], "");
+    int parseStatus = PARSER::parseOptions(&problem);
+    if (parseStatus) {
+      return parseStatus;
+    }
+    MODEL model = MODEL(&problem, argv[3]);
+    parseStatus = model.parse();
+    if (parseStatus) {
+      return parseStatus;
+    }
+    model.setModelsFile(argv[4]);
+    int printStatus = format == "--binary"    ? PRETTYPRINT::printBinaryModels(&model)
+                      : format == "--columns" ? PRETTYPRINT::printColumnModels(&model)
+                                              : model.print();
+    if (printStatus) {
+      return printStatus;
+    }
+    // stdout only contains the models in this case
+    if (std::string(argv[4]) != "-") {
+      std::cout << "\033[1;32mCOMPLETE\033[0m\n";
+    }
+    return 0;
+  }
 
   // Check if correct number of arguments were supplied
   if (argc != 5) {
@@ -47,7 +91,9 @@ int main(int argc, char **argv) {
     return printStatus;
   }
 
-  std::cout << "\033[1;32mCOMPLETE\033[0m\n";
+  if (std::string(argv[3]) != "-" && std::string(argv[4]) != "-") {
+    std::cout << "\033[1;32mCOMPLETE\033[0m\n";
+  }
 
   return 0;
 }
\ No newline at end of file
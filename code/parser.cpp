@@ -13,6 +13,21 @@
 #include "model.hpp"
 #include "problem.hpp"
 
+#include "binary.hpp"
+#include "compression.hpp"
+#include "dictionary.hpp"
+#include "parallel.hpp"
+#include "scanner.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+// Initialize the static member variable outside the class definition
+const std::size_t PARSER::minimumChunkSize = 1 << 20;
+
 PARSER::PARSER() {}
 PARSER::~PARSER() {}
 
@@ -36,7 +51,7 @@ int PARSER::parseOptions(PROBLEM *p) {
   }
 
   // Write parsed Data back to problem
-  p->setOptions(parsedData);
+  p->setOptions(std::move(parsedData));
   return 0;
 }
 
@@ -52,7 +67,7 @@ int PARSER::parseConstraints(PROBLEM *p) {
   }
 
   // Write parsed Data back to problem
-  p->setConstraints(parsedData);
+  p->setConstraints(std::move(parsedData));
   return 0;
 }
 
@@ -67,23 +82,187 @@ int PARSER::parseModel(MODEL *m) {
     return status;
   }
 
+  // Rows of a columnar file are stored as category and element pairs like
+  // the rows of any other file, the header is dropped
+  DICTIONARY d;
+  std::vector<int> columns;
+  if (!parsedData.empty() && d.build(m->getProblem()->getOptions(), {}) == 0 &&
+      d.compileHeader(parsedData[0], columns)) {
+    std::vector<std::string_view> fields;
+    for (std::size_t i = 1; i < parsedData.size(); i++) {
+      d.expandColumns(parsedData[i], columns, fields);
+      parsedData[i - 1].assign(fields.begin(), fields.end());
+    }
+    parsedData.pop_back();
+  }
+
   // Write parsed Data back to model
-  m->setModel(parsedData);
+  m->setModel(std::move(parsedData));
+  return 0;
+}
+
+int PARSER::mapModel(MODEL *m) {
+  std::shared_ptr<TABLE> table = std::make_shared<TABLE>();
+  int status = table->map(m->getModelsFile());
+  if (status) {
+    return status;
+  }
+
+  // Split file into rows and hand the table to the model
+  if (BINARY::isBinary(table->getData())) {
+    status = scanBinary(m->getModelsFile(), *table);
+    if (status) {
+      return status;
+    }
+  } else {
+    scan(*table);
+  }
+  m->setTable(table);
   return 0;
 }
 
+int PARSER::visit(const std::string &filename,
+                  const std::function<int(const FIELDS &)> &visitor,
+                  std::size_t offset, std::size_t *end) {
+  // stdin can not be mapped, it is read character by character instead so
+  // that it does not have to be stored. The same goes for compressed csv
+  // files, which are decompressed while they are read.
+  if (filename == "-" || isCompressedCsv(filename)) {
+    std::vector<std::string_view> fields;
+    return stream(
+        filename,
+        [&](const std::vector<std::string> &row) {
+          fields.assign(row.begin(), row.end());
+          return visitor(FIELDS(fields.data(), fields.data() + fields.size()));
+        },
+        offset, end);
+  }
+
+  TABLE table;
+  int status = table.map(filename);
+  if (status) {
+    return status;
+  }
+  std::string_view data = table.getData();
+  offset = std::min(offset, data.size());
+
+  // The table only holds the current row
+  table.setVisitor(visitor);
+  if (BINARY::isBinary(data)) {
+    status = scanBinary(filename, table, offset);
+    if (status) {
+      return status;
+    }
+  } else {
+    scanRange(data, offset, data.size(), false, table);
+  }
+  if (end) {
+    *end = std::max(offset, table.getScanned());
+  }
+  return table.getStatus();
+}
+
+int PARSER::visitIds(
+    const std::string &filename, const DICTIONARY &d,
+    const std::function<int(const FIELDS &, const std::vector<int> *)> &visitor,
+    std::size_t offset, std::size_t *end) {
+  // Each row is looked up as soon as its last field was found. If the first
+  // row is the header of a columnar file, the following rows are looked up
+  // column by column and expanded to names only for error messages.
+  std::vector<int> ids;
+  std::vector<int> columns;
+  std::vector<std::string_view> fields;
+  bool first = offset == 0 || filename == "-";
+  auto compile = [&](const FIELDS &row) {
+    if (first) {
+      first = false;
+      if (d.compileHeader(row, columns)) {
+        return 0;
+      }
+    }
+    if (columns.empty()) {
+      return visitor(row, d.compileRow(row, ids) ? &ids : nullptr);
+    }
+    if (d.compileColumns(row, columns, ids)) {
+      return visitor(row, &ids);
+    }
+    d.expandColumns(row, columns, fields);
+    return visitor(FIELDS(fields.data(), fields.data() + fields.size()),
+                   nullptr);
+  };
+  if (filename == "-" || isCompressedCsv(filename)) {
+    return visit(filename, compile, offset, end);
+  }
+
+  TABLE table;
+  int status = table.map(filename);
+  if (status) {
+    return status;
+  }
+  std::string_view data = table.getData();
+  offset = std::min(offset, data.size());
+
+  // Binary files already consist of ids
+  if (BINARY::isBinary(data)) {
+    return visitBinaryIds(filename, data, d, visitor, offset, end);
+  }
+
+  // Rows behind the offset still need the header of a columnar file
+  if (!first) {
+    TABLE header;
+    header.setVisitor([&](const FIELDS &row) {
+      d.compileHeader(row, columns);
+      return 1;
+    });
+    scanRange(data, 0, data.size(), false, header);
+  }
+
+  table.setVisitor(compile);
+  scanRange(data, offset, data.size(), false, table);
+  if (end) {
+    *end = std::max(offset, table.getScanned());
+  }
+  return table.getStatus();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Helper Functions                                                         //
 /////////////////////////////////////////////////////////////////////////////
 
 int PARSER::parse(std::string *filename,
                   std::vector<std::vector<std::string>> *parsedData) {
-  std::ifstream file(*filename);
+  return visit(*filename, [&](const FIELDS &row) {
+    parsedData->emplace_back(row.begin(), row.end());
+    return 0;
+  });
+}
 
-  // Attempt to open file, if impossible return error message & error code
-  if (!file.is_open()) {
-    LOGGER() << "Error opening file: " << filename << std::endl;
-    return 10;
+int PARSER::stream(
+    const std::string &filename,
+    const std::function<int(const std::vector<std::string> &)> &callback,
+    std::size_t offset, std::size_t *end) {
+  std::unique_ptr<std::istream> file;
+  std::istream *input = &std::cin;
+  std::size_t position = 0; // Byte offset of the next character
+  if (filename != "-") {
+    bool compressed = false;
+    file = COMPRESSION::openInput(filename, &compressed);
+    // Attempt to open file, if impossible return error message & error code
+    if (!file) {
+      LOGGER_INFO << "Error opening file: " << filename << std::endl;
+      return 10;
+    }
+    // Compressed files can not seek, the skipped part is decompressed
+    if (compressed) {
+      file->ignore(offset);
+    } else {
+      file->seekg(offset);
+    }
+    position = offset;
+    input = file.get();
+  }
+  if (end) {
+    *end = position;
   }
 
   // Temporary Storage Variables
@@ -91,26 +270,42 @@ int PARSER::parse(std::string *filename,
   std::vector<std::string> row;
   char c;
   bool insideQuotes = false;
+  char last = 0; // Previous character, used to detect CRLF line breaks
+  int status = 0;
 
-  while (file.get(c)) { // Iterate file, char by char
+  while (input->get(c)) { // Iterate file, char by char
+    position++;
+    char previous = last;
+    last = c;
 
     if (!insideQuotes &&
         (c == ',' || c == '\n')) // If c is separator and not inside quotes
     {
-      row.push_back(entry);         // Push string to row vector
-      entry.clear();                // and clear string for next loop
-      if (c == '\n') {              // If separator is newline
-        parsedData->push_back(row); // Push row to final vector
-        row.clear();                // and clear row for next loop
+      // A carriage return before the newline belongs to the line break
+      if (c == '\n' && previous == '\r' && !entry.empty()) {
+        entry.pop_back();
+      }
+      row.push_back(entry); // Push string to row vector
+      entry.clear();        // and clear string for next loop
+      if (c == '\n') {      // If separator is newline
+        status = callback(row); // Hand row to caller
+        row.clear();            // and clear row for next loop
+        if (end) {
+          *end = position;
+        }
+        if (status) {
+          return status;
+        }
       }
     }
 
     else if (c == '"') { // If c is a quotation mark
       if (insideQuotes) {
-        if (file.peek() == '"') { // Check for double quotation marks to handle
-                                  // quotes within quotes
-          entry += c;             // Add single quote to the entry
-          file.get(c);            // Skip the second quotation mark
+        if (input->peek() == '"') { // Check for double quotation marks to
+                                    // handle quotes within quotes
+          entry += c;               // Add single quote to the entry
+          input->get(c);            // Skip the second quotation mark
+          position++;
         } else {
           insideQuotes = false; // End of quoted entry
         }
@@ -130,11 +325,351 @@ int PARSER::parse(std::string *filename,
     row.push_back(entry); // Push string to row
   }
 
-  if (!row.empty()) {           // If row not empty when complete
-    parsedData->push_back(row); // Push row to final vector
+  // Compressed data was damaged
+  if (input->bad()) {
+    std::cerr << "Error reading file: " << filename
+              << " contains damaged compressed data" << std::endl;
+    return 10;
+  }
+
+  if (!row.empty()) { // If row not empty when complete
+    status = callback(row);
   }
 
-  file.close();
+  return status;
+}
+
+bool PARSER::isCompressedCsv(const std::string &filename) {
+  bool compressed = false;
+  std::unique_ptr<std::istream> input =
+      COMPRESSION::openInput(filename, &compressed);
+  if (!compressed) {
+    return false;
+  }
 
+  // Binary models files are decompressed completely, see TABLE::map()
+  char start[8];
+  input->read(start, sizeof(start));
+  return !BINARY::isBinary(std::string_view(start, input->gcount()));
+}
+
+void PARSER::scan(TABLE &table) {
+  std::string_view data = table.getData();
+
+  // Small files are not worth starting threads for
+  std::size_t chunks = PARALLEL::getThreads();
+  if (chunks < 2 || data.size() < minimumChunkSize * 2) {
+    scanRange(data, 0, data.size(), false, table);
+    return;
+  }
+
+  // Split file into ranges of whole blocks, each range gets the rows starting
+  // in it
+  std::size_t chunkSize = (data.size() + chunks - 1) / chunks;
+  chunkSize = std::max(minimumChunkSize, (chunkSize + 63) / 64 * 64);
+  chunks = (data.size() + chunkSize - 1) / chunkSize;
+  std::vector<TABLE> parts(chunks);
+  // Not std::vector<bool>, its elements share words and are written by
+  // several threads
+  std::vector<unsigned char> parities(chunks);
+  auto scanChunk = [&](std::size_t chunk, bool inside) {
+    std::size_t begin = chunk * chunkSize;
+    std::size_t end = std::min(data.size(), begin + chunkSize);
+    parities[chunk] = scanRange(data, begin, end, inside, parts[chunk]);
+  };
+
+  // First pass assumes that no range starts inside quotes
+  PARALLEL::run(chunks, 1,
+                [&](unsigned, std::size_t begin, std::size_t end) {
+                  for (std::size_t chunk = begin; chunk < end; chunk++) {
+                    scanChunk(chunk, false);
+                  }
+                });
+
+  // The real state at the start of each range follows from the number of
+  // quotes before it, ranges that were guessed wrong are scanned again
+  std::vector<std::size_t> wrong;
+  bool inside = false;
+  for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+    if (inside) {
+      wrong.push_back(chunk);
+    }
+    inside = inside != bool(parities[chunk]);
+  }
+  PARALLEL::run(wrong.size(), 1,
+                [&](unsigned, std::size_t begin, std::size_t end) {
+                  for (std::size_t i = begin; i < end; i++) {
+                    parts[wrong[i]].clearRows();
+                    scanChunk(wrong[i], true);
+                  }
+                });
+
+  // Stitch rows together in the order of the file
+  for (TABLE &part : parts) {
+    table.append(part);
+  }
+}
+
+bool PARSER::scanRange(std::string_view data, std::size_t begin,
+                       std::size_t end, bool inside, TABLE &table) {
+  const char *text = data.data();
+  std::size_t size = data.size();
+
+  // The first range starts with a row, every other range starts behind the
+  // first newline outside of quotes (the previous range finishes its last
+  // row)
+  bool started = begin == 0 || (!inside && text[begin - 1] == '\n');
+  std::size_t start = begin; // Start of the current field
+  bool quoted = false;       // Current field contains a quote
+  bool parity = false;       // Parity of the quotes in [begin, end)
+  std::uint64_t carry = inside ? ~std::uint64_t(0) : 0;
+  char padded[64]; // Copy of the last block, filled up with zeros
+
+  for (std::size_t base = begin; base < size; base += 64) {
+    const char *block = text + base;
+    if (size - base < 64) {
+      std::memset(padded, 0, sizeof(padded));
+      std::memcpy(padded, block, size - base);
+      block = padded;
+    }
+
+    // Commas and newlines are only separators outside of quotes, the state
+    // of each byte is the parity of the quotes before it
+    SCANNER::MASKS masks = SCANNER::classify(block);
+    std::uint64_t insideQuotes = SCANNER::prefixXor(masks.quotes) ^ carry;
+    carry = (insideQuotes >> 63) ? ~std::uint64_t(0) : 0;
+    std::uint64_t separators = (masks.commas | masks.newlines) & ~insideQuotes;
+    if (base < end) {
+      parity = parity != (__builtin_popcountll(masks.quotes) & 1);
+    }
+
+    // Handle each field ending in this block
+    unsigned from = 0; // First bit of the current field within the block
+    while (separators) {
+      unsigned bit = __builtin_ctzll(separators);
+      separators &= separators - 1;
+      std::uint64_t range = (~std::uint64_t(0) << from) &
+                            ((std::uint64_t(1) << bit) - 1);
+      quoted = quoted || (masks.quotes & range);
+      std::size_t position = base + bit;
+      bool newline = text[position] == '\n';
+
+      if (started) {
+        addField(table, data, data.substr(start, position - start), quoted,
+                 newline);
+        if (newline) {
+          table.endRow(position + 1);
+          // Visitor does not want any more rows
+          if (table.getStatus()) {
+            return parity;
+          }
+        }
+      }
+      start = position + 1;
+      from = bit + 1;
+      quoted = false;
+
+      // Rows starting behind the range belong to the next range
+      if (newline) {
+        if (start >= end) {
+          return parity;
+        }
+        started = true;
+      }
+    }
+    if (from < 64) {
+      quoted = quoted || (masks.quotes & (~std::uint64_t(0) << from));
+    }
+  }
+
+  // Last field if the file does not end with a newline
+  if (started && start < size) {
+    addField(table, data, data.substr(start), quoted, false);
+  }
+  if (table.isRowOpen()) {
+    table.endRow();
+  }
+  return parity;
+}
+
+void PARSER::addField(TABLE &table, std::string_view data,
+                      std::string_view field, bool quoted, bool newline) {
+  // A carriage return before the newline belongs to the line break
+  if (newline && !field.empty() && field.back() == '\r') {
+    field.remove_suffix(1);
+  }
+  bool last =
+      !newline && field.data() + field.size() == data.data() + data.size();
+
+  if (!quoted) {
+    // Empty fields at the end of the file are dropped
+    if (!last || !field.empty()) {
+      table.addField(field);
+    }
+    return;
+  }
+
+  // A field that is completely quoted without escaped quotes can still point
+  // into the file, only the quotes are left out
+  if (field.size() >= 2 && field.front() == '"' && field.back() == '"' &&
+      field.find('"', 1) == field.size() - 1) {
+    if (!last || field.size() > 2) {
+      table.addField(field.substr(1, field.size() - 2));
+    }
+    return;
+  }
+
+  // Otherwise remove the quotes like stream() does
+  std::string entry;
+  bool insideQuotes = false;
+  for (std::size_t i = 0; i < field.size(); i++) {
+    char c = field[i];
+    if (c == '"') {
+      if (insideQuotes && i + 1 < field.size() && field[i + 1] == '"') {
+        entry += c;
+        i++;
+      } else {
+        insideQuotes = !insideQuotes;
+      }
+    } else {
+      entry += c;
+    }
+  }
+  if (!last || !entry.empty()) {
+    table.addString(entry);
+  }
+}
+
+int PARSER::scanBinary(const std::string &filename, TABLE &table,
+                       std::size_t offset) {
+  std::string_view data = table.getData();
+  auto damaged = [&filename]() {
+    std::cerr << "Error reading file: " << filename
+              << " is not a valid binary models file" << std::endl;
+    return 10;
+  };
+
+  BINARY::HEADER header;
+  if (!BINARY::readHeader(data, header)) {
+    return damaged();
+  }
+  std::size_t categories = header.categories.size();
+  std::size_t rowSize = categories * header.width;
+
+  // Rows starting before the offset were read before
+  std::size_t first = 0;
+  if (offset > header.begin && rowSize > 0) {
+    first = std::min(header.rows,
+                     (offset - header.begin + rowSize - 1) / rowSize);
+  }
+  for (std::size_t row = first; row < header.rows; row++) {
+    std::size_t position = header.begin + row * rowSize;
+    for (std::size_t c = 0; c < categories; c++) {
+      std::uint64_t element;
+      BINARY::getInteger(data, position, header.width, element);
+      if (element >= header.elements[c].size()) {
+        return damaged();
+      }
+      table.addField(header.categories[c]);
+      table.addField(header.elements[c][element]);
+    }
+    // The last row also covers the checksum
+    table.endRow(row + 1 == header.rows ? data.size() : position);
+    if (table.getStatus()) {
+      break;
+    }
+  }
+  return 0;
+}
+
+int PARSER::visitBinaryIds(
+    const std::string &filename, std::string_view data, const DICTIONARY &d,
+    const std::function<int(const FIELDS &, const std::vector<int> *)> &visitor,
+    std::size_t offset, std::size_t *end) {
+  auto damaged = [&filename]() {
+    std::cerr << "Error reading file: " << filename
+              << " is not a valid binary models file" << std::endl;
+    return 10;
+  };
+  BINARY::HEADER header;
+  if (!BINARY::readHeader(data, header)) {
+    return damaged();
+  }
+  std::size_t categories = header.categories.size();
+  std::size_t rowSize = categories * header.width;
+
+  // Translate the names of the header once, -1 marks names the dictionary
+  // does not know. Rows can only be translated if the header contains every
+  // category exactly once.
+  bool complete = categories == std::size_t(d.getCategoryCount());
+  std::vector<int> categoryIds(categories);
+  std::vector<std::vector<int>> elementIds(categories);
+  std::vector<bool> seen(d.getCategoryCount(), false);
+  for (std::size_t c = 0; c < categories; c++) {
+    int category = d.findCategory(header.categories[c]);
+    if (category < 0 || seen[category]) {
+      complete = false;
+    } else {
+      seen[category] = true;
+    }
+    categoryIds[c] = category;
+    for (std::string_view element : header.elements[c]) {
+      elementIds[c].push_back(category < 0 ? -1
+                                           : d.findElement(category, element));
+    }
+  }
+
+  std::size_t first = 0;
+  if (offset > header.begin && rowSize > 0) {
+    first = std::min(header.rows,
+                     (offset - header.begin + rowSize - 1) / rowSize);
+  }
+  if (end) {
+    *end = offset;
+  }
+  std::vector<int> ids(d.getCategoryCount(), -1);
+  std::vector<std::string_view> fields;
+  for (std::size_t row = first; row < header.rows; row++) {
+    std::size_t position = header.begin + row * rowSize;
+    std::size_t start = position;
+    bool translated = complete;
+    for (std::size_t c = 0; c < categories; c++) {
+      std::uint64_t element;
+      BINARY::getInteger(data, position, header.width, element);
+      if (element >= elementIds[c].size()) {
+        return damaged();
+      }
+      if (elementIds[c][element] < 0) {
+        translated = false;
+      } else if (translated) {
+        ids[categoryIds[c]] = elementIds[c][element];
+      }
+    }
+
+    // Names are only needed for the error messages of rows that could not be
+    // translated
+    int status;
+    if (translated) {
+      status = visitor(FIELDS(nullptr, nullptr), &ids);
+    } else {
+      fields.clear();
+      position = start;
+      for (std::size_t c = 0; c < categories; c++) {
+        std::uint64_t element;
+        BINARY::getInteger(data, position, header.width, element);
+        fields.push_back(header.categories[c]);
+        fields.push_back(header.elements[c][element]);
+      }
+      status = visitor(FIELDS(fields.data(), fields.data() + fields.size()),
+                       nullptr);
+    }
+    // The last row also covers the checksum
+    if (end) {
+      *end = row + 1 == header.rows ? data.size() : position;
+    }
+    if (status) {
+      return status;
+    }
+  }
   return 0;
-}
\ No newline at end of file
+}
@@ -12,19 +12,29 @@
 #define PAIRWISE_PARSER
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "logger.hpp"
+#include "table.hpp"
 
 // Forwar declaration because of circular dependency
 class PROBLEM;
 class MODEL;
+class DICTIONARY;
 
 /**
  * @brief This class imports data to the PROBLEM and MODEL class
  */
 class PARSER {
+private:
+  /**
+   * @brief Smallest number of bytes scanned by one thread
+   */
+  static const std::size_t minimumChunkSize;
+
 public:
   PARSER();
   ~PARSER();
@@ -54,7 +64,177 @@ public:
    */
   static int parseModel(MODEL *m);
 
+  /**
+   * @brief Parses Model from csv file by mapping it into memory
+   * @note Unlike parseModel() the rows are not copied into the model, the
+   * model keeps the mapped file (see TABLE) instead. Files in the binary
+   * models format (see BINARY) are recognized and read as well.
+   *
+   * @param m instance of MODEL class to parse to
+   * @return int status code (see documentation)
+   */
+  static int mapModel(MODEL *m);
+
+  /**
+   * @brief Reads a csv file row by row without storing it
+   * @note Only the current row is kept in memory, the file is mapped and
+   * scanned like in mapModel(). Files in the binary models format are read
+   * as well. If filename is "-", stdin is read instead, which has to be
+   * csv. Compressed csv files are decompressed block by block while they are
+   * read, compressed binary files are decompressed completely.
+   *
+   * @param filename Filename of the input file
+   * @param visitor function called with the fields of each row, a return
+   * value other than 0 stops reading. The fields are only valid during the
+   * call.
+   * @param offset byte offset to start reading at, must be the start of a
+   * row. Ignored for stdin.
+   * @param end if not null, receives the byte offset behind the last row
+   * that was terminated by a newline
+   * @return int status code (see documentation), or the return value of the
+   * visitor that stopped reading
+   */
+  static int visit(const std::string &filename,
+                   const std::function<int(const FIELDS &)> &visitor,
+                   std::size_t offset = 0, std::size_t *end = nullptr);
+
+  /**
+   * @brief Reads a models file row by row and translates the names of each
+   * row to ids of a dictionary
+   * @note Like visit(), but the fields of a row are looked up right after
+   * they were found, without copying them. For binary models files only the
+   * names of the header are looked up, the rows are translated with a table.
+   * Columnar files (see DICTIONARY::compileHeader()) are recognized by their
+   * header, which is not passed to the visitor.
+   *
+   * @param filename Filename of the input file, "-" for stdin
+   * @param d dictionary the names are looked up in
+   * @param visitor function called for each row with its fields and its
+   * element ids indexed by category id (see DICTIONARY::compileRow()). If the
+   * row could not be translated the ids are null. The fields may be empty if
+   * the row was translated. A return value other than 0 stops reading.
+   * @param offset byte offset to start reading at, must be the start of a
+   * row. Ignored for stdin.
+   * @param end if not null, receives the byte offset behind the last row
+   * that was read completely
+   * @return int status code (see documentation), or the return value of the
+   * visitor that stopped reading
+   */
+  static int visitIds(
+      const std::string &filename, const DICTIONARY &d,
+      const std::function<int(const FIELDS &, const std::vector<int> *)>
+          &visitor,
+      std::size_t offset = 0, std::size_t *end = nullptr);
+
 private:
+  /**
+   * @brief Reads a csv file character by character, used for stdin and
+   * compressed files by visit()
+   *
+   * @param filename Filename of the input file, "-" for stdin. Compressed
+   * files are decompressed while they are read (see COMPRESSION).
+   * @param callback function called with each row, a return value other than
+   * 0 stops reading
+   * @param offset byte offset to start reading at, must be the start of a
+   * row. Ignored for stdin.
+   * @param end if not null, receives the byte offset behind the last row
+   * that was terminated by a newline
+   * @return int status code (see documentation), or the return value of the
+   * callback that stopped reading
+   */
+  static int
+  stream(const std::string &filename,
+         const std::function<int(const std::vector<std::string> &)> &callback,
+         std::size_t offset = 0, std::size_t *end = nullptr);
+
+  /**
+   * @brief Checks if a file is a compressed csv file, which visit() reads
+   * with stream() instead of decompressing it completely
+   *
+   * @param filename Filename of the input file
+   * @return true if the file is compressed and not a binary models file
+   * @return false otherwise
+   */
+  static bool isCompressedCsv(const std::string &filename);
+
+  /**
+   * @brief Splits the contents of a mapped file into rows and fields
+   * @note Follows the same rules as stream(), fields are only copied if they
+   * contain quotes that have to be removed. Large files are split into
+   * ranges that are scanned on several threads (see PARALLEL). Each range
+   * is first scanned assuming it does not start inside quotes, ranges where
+   * the quotes of the previous ranges show otherwise are scanned again.
+   *
+   * @param table table containing the mapped file, the rows are added to it
+   */
+  static void scan(TABLE &table);
+
+  /**
+   * @brief Scans all rows starting in a range of a mapped file
+   * @note The file is processed in blocks of 64 bytes using SCANNER, commas
+   * and newlines inside quotes are found with a prefix XOR over the quote
+   * positions. The last row is read completely, even if it ends behind the
+   * range.
+   *
+   * @param data contents of the mapped file
+   * @param begin start of the range, multiple of 64
+   * @param end end of the range
+   * @param inside true if the range starts inside quotes
+   * @param table table the rows are added to
+   * @return true if the range contains an odd number of quotes
+   * @return false otherwise
+   */
+  static bool scanRange(std::string_view data, std::size_t begin,
+                        std::size_t end, bool inside, TABLE &table);
+
+  /**
+   * @brief Adds a field found by scan() to the table
+   * @note Removes the quotes if the field contains any and drops the carriage
+   * return of CRLF line breaks
+   *
+   * @param table table the field is added to
+   * @param data contents of the mapped file
+   * @param field raw contents of the field, pointing into the mapped file
+   * @param quoted true if the field contains a quote
+   * @param newline true if the field is terminated by a newline
+   */
+  static void addField(TABLE &table, std::string_view data,
+                       std::string_view field, bool quoted, bool newline);
+
+  /**
+   * @brief Splits a mapped file in the binary models format into rows (see
+   * BINARY)
+   * @note The header and checksum are verified before any row is added. The
+   * fields point to the names in the header, so nothing is copied.
+   *
+   * @param filename Filename of the mapped file, used for error messages
+   * @param table table containing the mapped file, the rows are added to it
+   * @param offset byte offset to start reading at, rows starting before it
+   * are skipped
+   * @return int status code (see documentation), 10 if the file is damaged
+   */
+  static int scanBinary(const std::string &filename, TABLE &table,
+                        std::size_t offset = 0);
+
+  /**
+   * @brief Reads the rows of a mapped binary models file as ids, see
+   * visitIds()
+   *
+   * @param filename Filename of the mapped file, used for error messages
+   * @param data contents of the mapped file
+   * @param d dictionary the names of the header are looked up in
+   * @param visitor function called for each row
+   * @param offset byte offset to start reading at
+   * @param end if not null, receives the byte offset behind the last row
+   * that was read
+   * @return int status code (see documentation), 10 if the file is damaged
+   */
+  static int visitBinaryIds(
+      const std::string &filename, std::string_view data, const DICTIONARY &d,
+      const std::function<int(const FIELDS &, const std::vector<int> *)>
+          &visitor,
+      std::size_t offset, std::size_t *end);
+
   /**
    * @brief Helper function to parse a 2-dimensional vector from an input file
    *
@@ -0,0 +1,113 @@
+/**
+ * @file pipeline.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for PIPELINE class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "pipeline.hpp"
+#include "checker.hpp"
+#include "dictionary.hpp"
+#include "model.hpp"
+#include "prettyPrint.hpp"
+#include "queue.hpp"
+#include "solver.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Initialize the static member variable outside the class definition
+const std::size_t PIPELINE::queueSize = 1024;
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+int PIPELINE::run(MODEL *m, int strength) {
+  PROBLEM *p = m->getProblem();
+  std::string filename = m->getModelsFile();
+
+  // Open output file first, nothing is solved if it can not be written
+  std::unique_ptr<std::ostream> file = PRETTYPRINT::openSink(filename);
+  if (!file) {
+    std::cout << "Error opening file: " << filename << std::endl;
+    return 10;
+  }
+  std::ostream *out = file.get();
+
+  QUEUE<std::vector<std::string>> solved(queueSize);
+  QUEUE<std::vector<std::string>> checked(queueSize);
+
+  // Checker stage, each row is handed on to the writer when the checker
+  // asks for the next one
+  int checkStatus = 0;
+  std::thread checker([&]() {
+    std::vector<std::string> row;
+    bool pending = false;
+    checkStatus = CHECKER::checkSequence(
+        p, strength, filename, [&]() -> const std::vector<std::string> * {
+          if (pending) {
+            checked.push(std::move(row));
+          }
+          pending = solved.pop(row);
+          return pending ? &row : nullptr;
+        });
+    // The checker may stop before the last row if the problem is invalid
+    solved.cancel();
+    checked.close();
+  });
+
+  // Writer stage, takes every row even if writing failed
+  std::thread writer([&]() {
+    std::vector<std::string> row;
+    PRETTYPRINT::printRows(*out, [&]() -> const std::vector<std::string> * {
+      return checked.pop(row) ? &row : nullptr;
+    });
+    out->flush();
+  });
+
+  // Solver stage on this thread
+  DICTIONARY d;
+  bool sorted = d.build(p) == 0;
+  bool stopped = false;
+  int solveStatus =
+      SOLVER::generate(p, [&](std::vector<std::string> row) {
+        // Categories in the order of the options, like the rows of solve()
+        if (sorted) {
+          PRETTYPRINT::sortRow(d, row);
+        }
+        if (!solved.push(std::move(row))) {
+          stopped = true;
+          return 50;
+        }
+        return 0;
+      });
+  solved.close();
+  checker.join();
+  writer.join();
+
+  // Rows could not be handed over because the checker failed
+  if (stopped) {
+    return checkStatus;
+  }
+  if (solveStatus) {
+    return solveStatus;
+  }
+  // The checker may also fail after the solver handed over the last row,
+  // the previous file is kept in both cases
+  if (checkStatus && checkStatus != 100) {
+    return checkStatus;
+  }
+  if (!PRETTYPRINT::closeSink(file)) {
+    std::cout << "Error writing file: " << filename << std::endl;
+    return 10;
+  }
+  return checkStatus;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file pipeline.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for PIPELINE class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_PIPELINE
+#define PAIRWISE_PIPELINE
+
+#include <cstddef>
+
+// Forward declaration
+class MODEL;
+
+/**
+ * @brief Solves, checks and prints a model at the same time
+ * @note The solver runs on the calling thread and hands each row through a
+ * bounded QUEUE to the checker, which hands it on to the writer once it is
+ * checked. Checker and writer run on threads of their own. No stage keeps
+ * the rows, so the memory used does not depend on the number of rows, and
+ * writing the file overlaps with solving.
+ */
+class PIPELINE {
+public:
+  /**
+   * @brief Maximum number of rows waiting between two stages
+   */
+  static const std::size_t queueSize;
+
+  /**
+   * @brief Solves the problem of a model, checks the rows and writes them
+   * to the .models file
+   * @note If the filename of the model is "-" the rows are written to stdout.
+   * The rows are not stored in the model. If the problem or the rows are
+   * invalid, an existing .models file is left unchanged.
+   *
+   * @param m reference to instance of MODEL class containing the problem and
+   * the filename of the .models file
+   * @param strength number of categories per combination that has to be
+   * covered, default = 2 (pairwise)
+   * @return int status code (see documentation)
+   */
+  static int run(MODEL *m, int strength = 2);
+};
+
+#endif
@@ -10,8 +10,20 @@
  */
 
 #include "prettyPrint.hpp"
+#include "binary.hpp"
+#include "compression.hpp"
+#include "dictionary.hpp"
+#include "memory.hpp"
 #include "model.hpp"
 #include "problem.hpp"
+#include "parallel.hpp"
+#include "writer.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+// Initialize the static member variable outside the class definition
+const std::size_t PRETTYPRINT::minimumChunkRows = 1 << 14;
 
 PRETTYPRINT::PRETTYPRINT() {}
 PRETTYPRINT::~PRETTYPRINT() {}
@@ -20,10 +32,51 @@ PRETTYPRINT::~PRETTYPRINT() {}
 // Function Definitions                                                     //
 /////////////////////////////////////////////////////////////////////////////
 
+int PRETTYPRINT::sort(MODEL *m, bool sortRows) {
+  const std::vector<std::vector<std::string>> &models = m->getModels();
+  DICTIONARY d;
+  int status = d.build(m->getProblem());
+  if (status) {
+    return status;
+  }
+
+  // Rows are compared by their element ids, which follow the options
+  std::vector<std::vector<int>> rows(models.size());
+  for (std::size_t i = 0; i < models.size(); i++) {
+    if (!d.compileRow(models[i], rows[i])) {
+      std::cerr << "Row " << i + 1
+                << " of the models can not be sorted, it does not contain "
+                   "every category of the options exactly once"
+                << std::endl;
+      return 40;
+    }
+  }
+  if (sortRows) {
+    std::sort(rows.begin(), rows.end());
+  }
+
+  // Write the names back in the order of the categories
+  std::vector<std::vector<std::string>> sorted(rows.size());
+  for (std::size_t i = 0; i < rows.size(); i++) {
+    names(d, rows[i], sorted[i]);
+  }
+  m->setModel(std::move(sorted));
+  return 0;
+}
+
+bool PRETTYPRINT::sortRow(const DICTIONARY &d, std::vector<std::string> &row) {
+  std::vector<int> ids;
+  if (!d.compileRow(row, ids)) {
+    return false;
+  }
+  names(d, ids, row);
+  return true;
+}
+
 int PRETTYPRINT::printOptions(PROBLEM *p) {
   // Get required information from problem
   std::string filename = p->getOptionsFileOut();
-  std::vector<std::vector<std::string>> options = p->getOptions();
+  const std::vector<std::vector<std::string>> &options = p->getOptions();
 
   // Call print function
   int status = print(&filename, &options);
@@ -38,7 +91,8 @@ int PRETTYPRINT::printConstraints(PROBLEM *p) {
 
   // Get required information from problem
   std::string filename = p->getConstraintsFileOut();
-  std::vector<std::vector<std::string>> constraints = p->getConstraints();
+  const std::vector<std::vector<std::string>> &constraints =
+      p->getConstraints();
 
   // Call print function
   int status = print(&filename, &constraints);
@@ -52,7 +106,7 @@ int PRETTYPRINT::printConstraints(PROBLEM *p) {
 int PRETTYPRINT::printModels(MODEL *m) {
   // Get required information from problem
   std::string filename = m->getModelsFile();
-  std::vector<std::vector<std::string>> models = m->getModels();
+  const std::vector<std::vector<std::string>> &models = m->getModels();
 
   // Call print function
   int status = print(&filename, &models);
@@ -63,36 +117,311 @@ int PRETTYPRINT::printModels(MODEL *m) {
   return 0;
 }
 
+int PRETTYPRINT::printBinaryModels(MODEL *m) {
+  std::string filename = m->getModelsFile();
+  const std::vector<std::vector<std::string>> &models = m->getModels();
+
+  // The header stores the names in the order of the options
+  DICTIONARY d;
+  int status = d.build(m->getProblem());
+  if (status) {
+    return status;
+  }
+  int width = 1;
+  for (int c = 0; c < d.getCategoryCount(); c++) {
+    if (d.getElementCount(c) > 65536) {
+      std::cerr << "Category " << d.getCategoryName(c)
+                << " has too many elements for the binary format" << std::endl;
+      return 50;
+    }
+    if (d.getElementCount(c) > 256) {
+      width = 2;
+    }
+  }
+
+  std::unique_ptr<std::ostream> file = openSink(filename);
+  if (!file) {
+    std::cout << "Error opening file: " << filename << std::endl;
+    return 10;
+  }
+
+  // Everything behind the magic is added to the checksum when it is written
+  std::uint64_t checksum = BINARY::checksum("");
+  std::string buffer;
+  auto flush = [&]() {
+    checksum = BINARY::checksum(buffer, checksum);
+    file->write(buffer.data(), buffer.size());
+    buffer.clear();
+  };
+  file->write(BINARY::magic.data(), BINARY::magic.size());
+  BINARY::putInteger(buffer, BINARY::version, 4);
+  BINARY::putInteger(buffer, width, 4);
+  BINARY::putInteger(buffer, d.getCategoryCount(), 4);
+  auto putName = [&buffer](const std::string &name) {
+    BINARY::putInteger(buffer, name.size(), 4);
+    buffer += name;
+  };
+  for (int c = 0; c < d.getCategoryCount(); c++) {
+    putName(d.getCategoryName(c));
+    BINARY::putInteger(buffer, d.getElementCount(c), 4);
+    for (int e = 0; e < d.getElementCount(c); e++) {
+      putName(d.getElementName(c, e));
+    }
+  }
+  BINARY::putInteger(buffer, models.size(), 8);
+
+  // Rows in the order of the categories in the header
+  std::vector<int> ids;
+  for (std::size_t i = 0; i < models.size(); i++) {
+    if (!d.compileRow(models[i], ids)) {
+      std::cerr << "Row " << i + 1 << " of " << filename
+                << " can not be stored in the binary format" << std::endl;
+      return 40;
+    }
+    for (int id : ids) {
+      BINARY::putInteger(buffer, id, width);
+    }
+    if (buffer.size() >= 1 << 20) {
+      flush();
+    }
+  }
+  flush();
+  BINARY::putInteger(buffer, checksum, 8);
+  file->write(buffer.data(), buffer.size());
+
+  if (!closeSink(file)) {
+    std::cout << "Error writing file: " << filename << std::endl;
+    return 10;
+  }
+  return 0;
+}
+
+int PRETTYPRINT::printColumnModels(MODEL *m) {
+  std::string filename = m->getModelsFile();
+  const std::vector<std::vector<std::string>> &models = m->getModels();
+
+  // The header lists the categories in the order of the options
+  DICTIONARY d;
+  int status = d.build(m->getProblem());
+  if (status) {
+    return status;
+  }
+  std::vector<std::string> columns(d.getCategoryCount());
+  for (int c = 0; c < d.getCategoryCount(); c++) {
+    columns[c] = d.getCategoryName(c);
+  }
+
+  std::unique_ptr<std::ostream> file = openSink(filename);
+  if (!file) {
+    std::cout << "Error opening file: " << filename << std::endl;
+    return 10;
+  }
+
+  // The header is followed by the element names of each row, the file is
+  // not finished if a row can not be translated
+  std::size_t i = 0;
+  bool header = true;
+  std::vector<int> ids;
+  printRows(*file, [&]() -> const std::vector<std::string> * {
+    if (header) {
+      header = false;
+      return &columns;
+    }
+    if (i == models.size()) {
+      return nullptr;
+    }
+    if (!d.compileRow(models[i], ids)) {
+      std::cerr << "Row " << i + 1 << " of " << filename
+                << " can not be stored in the columnar format" << std::endl;
+      status = 40;
+      return nullptr;
+    }
+    for (int c = 0; c < d.getCategoryCount(); c++) {
+      columns[c] = d.getElementName(c, ids[c]);
+    }
+    i++;
+    return &columns;
+  });
+  if (status) {
+    return status;
+  }
+
+  if (!closeSink(file)) {
+    std::cout << "Error writing file: " << filename << std::endl;
+    return 10;
+  }
+  return 0;
+}
+
+std::unique_ptr<std::ostream> PRETTYPRINT::openSink(const std::string &target,
+                                                   bool direct) {
+  // stdout is shared, the stream only borrows its buffer
+  if (target == "-") {
+    return std::make_unique<std::ostream>(std::cout.rdbuf());
+  }
+  if (MEMORY::isMemory(target)) {
+    return std::make_unique<MEMORYSTREAM>(target);
+  }
+  return COMPRESSION::openOutput(target, direct);
+}
+
+bool PRETTYPRINT::closeSink(std::unique_ptr<std::ostream> &out) {
+  if (MEMORYSTREAM *memory = dynamic_cast<MEMORYSTREAM *>(out.get())) {
+    bool written = memory->finish();
+    out.reset();
+    return written;
+  }
+  return COMPRESSION::close(out);
+}
+
+void PRETTYPRINT::printRow(std::ostream &out,
+                           const std::vector<std::string> &row) {
+  // Format the row first, so the stream is only called once
+  std::string buffer;
+  appendRow(buffer, row);
+  out.write(buffer.data(), buffer.size());
+}
+
+void PRETTYPRINT::printRows(
+    std::ostream &out,
+    const std::function<const std::vector<std::string> *()> &next) {
+  // Format rows into one buffer, which is handed to the stream whenever it
+  // is full, instead of writing each field to the stream
+  std::string buffer;
+  buffer.reserve(WRITER::bufferSize + 4096);
+  while (const std::vector<std::string> *row = next()) {
+    appendRow(buffer, *row);
+    if (buffer.size() >= WRITER::bufferSize) {
+      out.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+  out.write(buffer.data(), buffer.size());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Helper Functions                                                         //
 /////////////////////////////////////////////////////////////////////////////
 
 int PRETTYPRINT::print(std::string *filename,
-                       std::vector<std::vector<std::string>> *vector) {
-  std::ofstream file(*filename);
+                       const std::vector<std::vector<std::string>> *vector) {
+  // Files ending with .gz or .zst are compressed while they are written
+  std::unique_ptr<std::ostream> file = openSink(*filename);
 
   // Check if opening file was succesfull, otherwise return error message & code
-  if (!file.is_open()) {
-    std::cout << "Error opening file: " << filename << std::endl;
+  if (!file) {
+    std::cout << "Error opening file: " << *filename << std::endl;
     return 10;
   }
 
-  // Iterate through vector and print to file
-  for (const auto &row : *vector) {
-    for (std::size_t i = 0; i < row.size(); ++i) {
-      if (row[i].find(',') != std::string::npos) {
-        // If the string contains a comma, enclose it in quotes
-        file << '"' << row[i] << '"';
-      } else {
-        file << row[i];
-      }
-      if (i != row.size() - 1) {
-        file << ",";
-      }
-    }
-    file << "\n";
+  // Large uncompressed files are formatted on several threads, everything
+  // else is written in order
+  WRITER *writer = dynamic_cast<WRITER *>(file.get());
+  bool parallel = writer && PARALLEL::getThreads() > 1 &&
+                  vector->size() >= 2 * minimumChunkRows;
+  if (parallel && !printParallel(*writer, *vector)) {
+    writer->setstate(std::ios::badbit);
+  } else if (!parallel) {
+    // Iterate through vector and print to file
+    std::size_t i = 0;
+    printRows(*file, [&]() -> const std::vector<std::string> * {
+      return i < vector->size() ? &(*vector)[i++] : nullptr;
+    });
   }
 
-  file.close();
+  if (!closeSink(file)) {
+    std::cout << "Error writing file: " << *filename << std::endl;
+    return 10;
+  }
   return 0;
 }
+
+bool PRETTYPRINT::printParallel(
+    WRITER &file, const std::vector<std::vector<std::string>> &rows) {
+  // Both passes split the rows into the same chunks
+  std::vector<std::size_t> offsets(PARALLEL::getThreads() + 1, 0);
+  unsigned chunks = PARALLEL::run(
+      rows.size(), minimumChunkRows,
+      [&](unsigned chunk, std::size_t begin, std::size_t end) {
+        std::size_t size = 0;
+        for (std::size_t i = begin; i < end; i++) {
+          size += rowSize(rows[i]);
+        }
+        offsets[chunk + 1] = size;
+      });
+
+  // Each chunk starts where the previous one ends
+  for (unsigned chunk = 0; chunk < chunks; chunk++) {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+  // Devices and pipes can not take positioned writes, they get the rows in
+  // order instead
+  std::size_t base;
+  if (!file.reserve(offsets[chunks], base)) {
+    std::size_t i = 0;
+    printRows(file, [&]() -> const std::vector<std::string> * {
+      return i < rows.size() ? &rows[i++] : nullptr;
+    });
+    return bool(file);
+  }
+
+  std::atomic<bool> written(true);
+  PARALLEL::run(rows.size(), minimumChunkRows,
+                [&](unsigned chunk, std::size_t begin, std::size_t end) {
+                  std::string buffer;
+                  buffer.reserve(WRITER::bufferSize + 4096);
+                  std::size_t offset = base + offsets[chunk];
+                  for (std::size_t i = begin; i < end && written; i++) {
+                    appendRow(buffer, rows[i]);
+                    if (buffer.size() >= WRITER::bufferSize || i + 1 == end) {
+                      if (!file.writeAt(buffer.data(), buffer.size(),
+                                        offset)) {
+                        written = false;
+                      }
+                      offset += buffer.size();
+                      buffer.clear();
+                    }
+                  }
+                });
+  return written;
+}
+
+void PRETTYPRINT::appendRow(std::string &out,
+                            const std::vector<std::string> &row) {
+  for (std::size_t i = 0; i < row.size(); ++i) {
+    if (i) {
+      out += ',';
+    }
+    if (row[i].find(',') != std::string::npos) {
+      // If the string contains a comma, enclose it in quotes
+      out += '"';
+      out += row[i];
+      out += '"';
+    } else {
+      out += row[i];
+    }
+  }
+  out += '\n';
+}
+
+std::size_t PRETTYPRINT::rowSize(const std::vector<std::string> &row) {
+  // Separators and the line break, plus two quotes for fields with a comma
+  std::size_t size = row.empty() ? 1 : row.size();
+  for (const std::string &field : row) {
+    size += field.size();
+    if (field.find(',') != std::string::npos) {
+      size += 2;
+    }
+  }
+  return size;
+}
+
+void PRETTYPRINT::names(const DICTIONARY &d, const std::vector<int> &ids,
+                        std::vector<std::string> &row) {
+  row.clear();
+  row.reserve(2 * ids.size());
+  for (int c = 0; c < d.getCategoryCount(); c++) {
+    row.push_back(d.getCategoryName(c));
+    row.push_back(d.getElementName(c, ids[c]));
+  }
+}
@@ -10,7 +10,9 @@
  */
 
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,20 +21,49 @@
 
 class PROBLEM;
 class MODEL;
+class WRITER;
+class DICTIONARY;
 
 /**
  * @brief This class prints the data from the PROBLEM and MODEL class to CSV
  * files
  */
 class PRETTYPRINT {
+private:
+  /**
+   * @brief Smallest number of rows formatted by one thread
+   */
+  static const std::size_t minimumChunkRows;
+
 public:
   PRETTYPRINT();
   ~PRETTYPRINT();
 
   /**
-   * @brief Sort the parsed data
+   * @brief Sort the models into a canonical order, so that models files of
+   * the same rows are identical
+   * @note The categories of every row are put in the order of the options.
+   * Sorted rows are ordered by the positions of their elements in the
+   * options, comparing the first category first.
+   *
+   * @param m reference to instance of MODEL class containing the models and
+   * the problem whose options define the order
+   * @param sortRows true to sort the rows as well, false to keep their order
+   * @return int status code (see documentation)
    */
-  static void sort(PROBLEM *p);
+  static int sort(MODEL *m, bool sortRows = false);
+
+  /**
+   * @brief Puts the categories of a single row in the order of the options,
+   * like sort() does for every row
+   *
+   * @param d dictionary containing the compiled problem
+   * @param row row to be reordered
+   * @return true if the row was reordered
+   * @return false if the row does not contain every category of the options
+   * exactly once, the row is left unchanged
+   */
+  static bool sortRow(const DICTIONARY &d, std::vector<std::string> &row);
 
   /**
    * @brief Print Options to specified output file
@@ -62,6 +93,78 @@ public:
    */
   static int printModels(MODEL *m);
 
+  /**
+   * @brief Print models to specified output file in the binary models format
+   * (see BINARY)
+   * @note Element ids use one byte if no category has more than 256 elements
+   * and two bytes otherwise. Every row must contain each category of the
+   * options exactly once.
+   *
+   * @param m reference to instance of MODEL class containing the models,
+   * filename and the problem whose options make up the header
+   * @return int status code (see documentation)
+   */
+  static int printBinaryModels(MODEL *m);
+
+  /**
+   * @brief Print models to specified output file in the columnar models
+   * format
+   * @note The first row names the categories in the order of the options,
+   * every following row only contains the element of each category in the
+   * same order. Every row must contain each category of the options exactly
+   * once.
+   *
+   * @param m reference to instance of MODEL class containing the models,
+   * filename and the problem whose options make up the header
+   * @return int status code (see documentation)
+   */
+  static int printColumnModels(MODEL *m);
+
+  /**
+   * @brief Opens the target all output is written to
+   * @note "-" writes to stdout, so that the output can be piped into another
+   * program. Names starting with "mem:" write a memory file (see MEMORY).
+   * Any other name is a file, which is compressed if it ends with .gz or .zst
+   * (see COMPRESSION::openOutput()).
+   *
+   * @param target "-", the name of a memory file or a filename
+   * @param direct true to write a file directly instead of replacing it at
+   * the end, see WRITER
+   * @return std::unique_ptr<std::ostream> stream, null if the target can not
+   * be opened
+   */
+  static std::unique_ptr<std::ostream> openSink(const std::string &target,
+                                                bool direct = false);
+
+  /**
+   * @brief Finishes and closes a stream returned by openSink()
+   *
+   * @param out stream to be closed, reset afterwards
+   * @return true if all data was written
+   * @return false otherwise
+   */
+  static bool closeSink(std::unique_ptr<std::ostream> &out);
+
+  /**
+   * @brief Print a single row in CSV format to an output stream
+   *
+   * @param out stream the row is written to
+   * @param row vector of strings to be printed as one row
+   */
+  static void printRow(std::ostream &out, const std::vector<std::string> &row);
+
+  /**
+   * @brief Print rows in CSV format to an output stream, the rows are
+   * formatted into a large buffer which is written whenever it is full
+   *
+   * @param out stream the rows are written to
+   * @param next function returning the next row, nullptr after the last row.
+   * The row must stay valid until next is called again.
+   */
+  static void
+  printRows(std::ostream &out,
+            const std::function<const std::vector<std::string> *()> &next);
+
 private:
   /**
    * @brief Helper function to print a 2-dimensional vecotr to a CSV file
@@ -71,7 +174,51 @@ private:
    * @return int status code (see documentation)
    */
   static int print(std::string *filename,
-                   std::vector<std::vector<std::string>> *vector);
+                   const std::vector<std::vector<std::string>> *vector);
+
+  /**
+   * @brief Helper function to print rows in CSV format on several threads
+   * @note The size of every chunk of rows is calculated first, so that the
+   * whole output can be reserved in the file. Each thread then formats its
+   * chunk into its own buffer and writes it to the position of the chunk.
+   * The result is the same as printRows() would write, which is used instead
+   * if the file is not a regular file.
+   *
+   * @param file file the rows are written to
+   * @param rows rows to be printed
+   * @return true if all rows were written
+   * @return false otherwise
+   */
+  static bool printParallel(WRITER &file,
+                            const std::vector<std::vector<std::string>> &rows);
+
+  /**
+   * @brief Helper function to calculate the size of a row formatted by
+   * appendRow()
+   *
+   * @param row vector of strings to be printed as one row
+   * @return std::size_t number of characters
+   */
+  static std::size_t rowSize(const std::vector<std::string> &row);
+
+  /**
+   * @brief Helper function to turn element ids back into a row of category
+   * and element names in the order of the options
+   *
+   * @param d dictionary containing the compiled problem
+   * @param ids element id of each category
+   * @param row receives the names
+   */
+  static void names(const DICTIONARY &d, const std::vector<int> &ids,
+                    std::vector<std::string> &row);
+
+  /**
+   * @brief Helper function to append a single row in CSV format to a buffer
+   *
+   * @param out buffer the row is appended to
+   * @param row vector of strings to be printed as one row
+   */
+  static void appendRow(std::string &out, const std::vector<std::string> &row);
 };
 
 #endif
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include "parser.hpp"
 #include "prettyPrint.hpp"
 
+#include <utility>
+
 PROBLEM::PROBLEM()
     : m_optionFileIn{"Error"}, m_constrainFileIn{"Error"},
       m_optionFileOut("Error"), m_constrainFileOut{"Error"} {}
@@ -52,21 +54,22 @@ int PROBLEM::print() {
     return 10;
 }
 
-std::vector<std::vector<std::string>> PROBLEM::getOptions() const {
+const std::vector<std::vector<std::string>> &PROBLEM::getOptions() const {
   return m_options;
 }
 
-std::vector<std::vector<std::string>> PROBLEM::getConstraints() const {
+const std::vector<std::vector<std::string>> &
+PROBLEM::getConstraints() const {
   return m_constraints;
 }
 
 void PROBLEM::setOptions(std::vector<std::vector<std::string>> options) {
-  m_options = options;
+  m_options = std::move(options);
 }
 
 void PROBLEM::setConstraints(
     std::vector<std::vector<std::string>> constraints) {
-  m_constraints = constraints;
+  m_constraints = std::move(constraints);
 }
 
 std::string PROBLEM::getOptionsFileIn() const { return m_optionFileIn; }
@@ -63,16 +63,18 @@ public:
   /**
    * @brief Getter function for #m_options vector
    *
-   * @return Parsed options as std::vector<std::vector<std::string>>
+   * @return Reference to parsed options as
+   * std::vector<std::vector<std::string>>
    */
-  std::vector<std::vector<std::string>> getOptions() const;
+  const std::vector<std::vector<std::string>> &getOptions() const;
 
   /**
    * @brief Getter function for #m_constraints vector
    *
-   * @return Parsed constraints as std::vector<std::vector<std::string>>
+   * @return Reference to parsed constraints as
+   * std::vector<std::vector<std::string>>
    */
-  std::vector<std::vector<std::string>> getConstraints() const;
+  const std::vector<std::vector<std::string>> &getConstraints() const;
 
   /**
    * @brief Set the #m_options vector
@@ -0,0 +1,150 @@
+/**
+ * @file queue.hpp
+ * @author Max Heinekamp
+ * @brief Contains declaration and definition of the QUEUE class template
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_QUEUE
+#define PAIRWISE_QUEUE
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Bounded queue passing items from one producer thread to one
+ * consumer thread without locks
+ * @note The items live in a ring buffer of fixed size. Producer and consumer
+ * only share the positions of both ends, a full or empty queue makes the
+ * waiting side yield its time slice until the other side caught up.
+ *
+ * @tparam T type of the items
+ */
+template <typename T> class QUEUE {
+public:
+  /**
+   * @brief Creates an empty queue
+   *
+   * @param capacity maximum number of items, rounded up to a power of two
+   */
+  explicit QUEUE(std::size_t capacity)
+      : m_mask(roundUp(capacity) - 1), m_items(new T[m_mask + 1]), m_head(0),
+        m_tail(0), m_closed(false), m_cancelled(false) {}
+
+  // The ring buffer is shared by two threads, so copying is not allowed
+  QUEUE(const QUEUE &) = delete;
+  QUEUE &operator=(const QUEUE &) = delete;
+
+  /**
+   * @brief Adds an item, waits while the queue is full
+   * @note Must only be called by the producer
+   *
+   * @param item item to be moved into the queue
+   * @return true if the item was added
+   * @return false if the consumer cancelled the queue
+   */
+  bool push(T &&item) {
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    while (tail - m_head.load(std::memory_order_acquire) > m_mask) {
+      if (m_cancelled.load(std::memory_order_acquire)) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    if (m_cancelled.load(std::memory_order_acquire)) {
+      return false;
+    }
+    m_items[tail & m_mask] = std::move(item);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest item, waits while the queue is empty
+   * @note Must only be called by the consumer
+   *
+   * @param item receives the item
+   * @return true if an item was removed
+   * @return false if the queue is empty and the producer closed it
+   */
+  bool pop(T &item) {
+    std::size_t head = m_head.load(std::memory_order_relaxed);
+    while (head == m_tail.load(std::memory_order_acquire)) {
+      // Items pushed before closing are still returned
+      if (m_closed.load(std::memory_order_acquire) &&
+          head == m_tail.load(std::memory_order_acquire)) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    item = std::move(m_items[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Tells the consumer that no more items will be added
+   * @note Must only be called by the producer
+   */
+  void close() { m_closed.store(true, std::memory_order_release); }
+
+  /**
+   * @brief Tells the producer that no more items will be removed, so that
+   * it does not wait for space forever
+   * @note Must only be called by the consumer
+   */
+  void cancel() { m_cancelled.store(true, std::memory_order_release); }
+
+private:
+  /**
+   * @brief Rounds a capacity up to the next power of two
+   *
+   * @param capacity requested capacity
+   * @return std::size_t power of two, at least 2
+   */
+  static std::size_t roundUp(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) {
+      size *= 2;
+    }
+    return size;
+  }
+
+  /**
+   * @brief Capacity minus one, masks positions to slots of #m_items
+   */
+  const std::size_t m_mask;
+
+  /**
+   * @brief Ring buffer of items
+   */
+  std::unique_ptr<T[]> m_items;
+
+  /**
+   * @brief Number of items removed so far, written by the consumer
+   */
+  alignas(64) std::atomic<std::size_t> m_head;
+
+  /**
+   * @brief Number of items added so far, written by the producer
+   */
+  alignas(64) std::atomic<std::size_t> m_tail;
+
+  /**
+   * @brief Set by the producer after the last item
+   */
+  std::atomic<bool> m_closed;
+
+  /**
+   * @brief Set by the consumer if it stops removing items
+   */
+  std::atomic<bool> m_cancelled;
+};
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file report.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for REPORT class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "report.hpp"
+#include "logger.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+REPORT::REPORT() : m_status(0) {}
+
+REPORT::~REPORT() {}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+void REPORT::startPhase(const std::string &name) {
+  stopPhase();
+  m_phase = name;
+  m_start = std::chrono::steady_clock::now();
+}
+
+void REPORT::stopPhase() {
+  if (m_phase.empty()) {
+    return;
+  }
+  std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - m_start;
+  m_phases.push_back(std::make_pair(m_phase, duration.count()));
+  m_phase.clear();
+}
+
+void REPORT::addRow(std::size_t added) { m_added.push_back(added); }
+
+void REPORT::setStatus(int status) { m_status = status; }
+
+int REPORT::write(const std::string &filename, const std::string &modelsFile,
+                  const DICTIONARY &d, const COVERAGE &coverage,
+                  const std::vector<std::size_t> &infeasible) const {
+  if (filename == "-") {
+    print(std::cout, modelsFile, d, coverage, infeasible);
+    return 0;
+  }
+
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    LOGGER_INFO << "Error opening file: " << filename << std::endl;
+    return 10;
+  }
+  print(file, modelsFile, d, coverage, infeasible);
+  return file ? 0 : 10;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper Functions                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+void REPORT::print(std::ostream &out, const std::string &modelsFile,
+                   const DICTIONARY &d, const COVERAGE &coverage,
+                   const std::vector<std::size_t> &infeasible) const {
+  // Infeasible combinations do not count towards the coverage
+  std::vector<bool> excluded(coverage.getCount(), false);
+  for (std::size_t index : infeasible) {
+    excluded[index] = true;
+  }
+
+  // Count covered combinations of each block of categories and how often
+  // each feasible combination is hit
+  const auto &blocks = coverage.getCategories();
+  std::vector<std::size_t> feasible(blocks.size(), 0);
+  std::vector<std::size_t> covered(blocks.size(), 0);
+  std::map<std::uint32_t, std::size_t> histogram;
+  std::vector<std::size_t> uncovered;
+  for (std::size_t b = 0; b < blocks.size(); b++) {
+    for (std::size_t index = coverage.getOffset(b);
+         index < coverage.getOffset(b + 1); index++) {
+      if (excluded[index]) {
+        continue;
+      }
+      feasible[b]++;
+      histogram[coverage.getHits(index)]++;
+      if (coverage.isCovered(index)) {
+        covered[b]++;
+      } else {
+        uncovered.push_back(index);
+      }
+    }
+  }
+  std::size_t totalFeasible = coverage.getCount() - infeasible.size();
+  std::size_t totalCovered = totalFeasible - uncovered.size();
+  auto percent = [](std::size_t part, std::size_t total) {
+    return total ? 100.0 * part / total : 100.0;
+  };
+
+  out << "{\n";
+  out << "  \"file\": ";
+  printString(out, modelsFile);
+  out << ",\n";
+  out << "  \"strength\": " << coverage.getStrength() << ",\n";
+  out << "  \"status\": " << m_status << ",\n";
+  out << "  \"rows\": " << m_added.size() << ",\n";
+  out << "  \"combinations\": " << coverage.getCount() << ",\n";
+  out << "  \"feasible\": " << totalFeasible << ",\n";
+  out << "  \"covered\": " << totalCovered << ",\n";
+  out << "  \"coverage\": " << percent(totalCovered, totalFeasible) << ",\n";
+
+  // Coverage of each combination of categories
+  out << "  \"categories\": [";
+  for (std::size_t b = 0; b < blocks.size(); b++) {
+    out << (b ? ",\n" : "\n") << "    {\"categories\": [";
+    for (std::size_t i = 0; i < blocks[b].size(); i++) {
+      out << (i ? ", " : "");
+      printString(out, d.getCategoryName(blocks[b][i]));
+    }
+    out << "], \"feasible\": " << feasible[b]
+        << ", \"covered\": " << covered[b]
+        << ", \"coverage\": " << percent(covered[b], feasible[b]) << "}";
+  }
+  out << (blocks.empty() ? "],\n" : "\n  ],\n");
+
+  // Number of feasible combinations covered by exactly n rows
+  out << "  \"hits\": [";
+  bool first = true;
+  for (const auto &bucket : histogram) {
+    out << (first ? "\n" : ",\n") << "    {\"rows\": " << bucket.first
+        << ", \"combinations\": " << bucket.second << "}";
+    first = false;
+  }
+  out << (histogram.empty() ? "],\n" : "\n  ],\n");
+
+  // Combinations each row covers first, in the order of the rows
+  out << "  \"new\": [";
+  for (std::size_t i = 0; i < m_added.size(); i++) {
+    out << (i ? (i % 20 ? ", " : ",\n    ") : "\n    ") << m_added[i];
+  }
+  out << (m_added.empty() ? "],\n" : "\n  ],\n");
+
+  out << "  \"uncovered\": [";
+  for (std::size_t i = 0; i < uncovered.size(); i++) {
+    out << (i ? ",\n    " : "\n    ");
+    printCombination(out, d, coverage, uncovered[i]);
+  }
+  out << (uncovered.empty() ? "],\n" : "\n  ],\n");
+
+  out << "  \"infeasible\": [";
+  for (std::size_t i = 0; i < infeasible.size(); i++) {
+    out << (i ? ",\n    " : "\n    ");
+    printCombination(out, d, coverage, infeasible[i]);
+  }
+  out << (infeasible.empty() ? "],\n" : "\n  ],\n");
+
+  // Duration of each phase of the check
+  out << "  \"phases\": [";
+  for (std::size_t i = 0; i < m_phases.size(); i++) {
+    out << (i ? ",\n" : "\n") << "    {\"name\": ";
+    printString(out, m_phases[i].first);
+    out << ", \"seconds\": " << m_phases[i].second << "}";
+  }
+  out << (m_phases.empty() ? "]\n" : "\n  ]\n");
+  out << "}\n";
+}
+
+void REPORT::printString(std::ostream &out, const std::string &text) {
+  out << '"';
+  for (unsigned char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (c < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out << escaped;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+void REPORT::printCombination(std::ostream &out, const DICTIONARY &d,
+                              const COVERAGE &coverage, std::size_t index) {
+  std::vector<int> categories;
+  std::vector<int> elements;
+  coverage.decode(index, categories, elements);
+  out << "[";
+  for (std::size_t i = 0; i < categories.size(); i++) {
+    out << (i ? ", " : "");
+    printString(out, d.getCategoryName(categories[i]));
+    out << ", ";
+    printString(out, d.getElementName(categories[i], elements[i]));
+  }
+  out << "]";
+}
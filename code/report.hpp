@@ -0,0 +1,136 @@
+/**
+ * @file report.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for REPORT class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_REPORT
+#define PAIRWISE_REPORT
+
+#include "coverage.hpp"
+#include "dictionary.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Collects coverage metrics during a check and writes them as JSON
+ * @note The metrics are taken from the COVERAGE bitmap of the check, which
+ * needs countHits() enabled for the histogram
+ */
+class REPORT {
+public:
+  REPORT();
+  ~REPORT();
+
+  /**
+   * @brief Starts timing a new phase of the check, the previous phase ends
+   *
+   * @param name name of the phase
+   */
+  void startPhase(const std::string &name);
+
+  /**
+   * @brief Ends timing the current phase
+   */
+  void stopPhase();
+
+  /**
+   * @brief Records a valid row
+   *
+   * @param added number of combinations the row covers first
+   */
+  void addRow(std::size_t added);
+
+  /**
+   * @brief Records the result of checking the rows
+   *
+   * @param status status code of the row checks, 0 if every checked row was
+   * valid
+   */
+  void setStatus(int status);
+
+  /**
+   * @brief Writes the report
+   *
+   * @param filename name of the report file, "-" for stdout
+   * @param modelsFile name of the checked .models file
+   * @param d dictionary containing the compiled problem
+   * @param coverage bitmap of the combinations covered by the rows, before
+   * infeasible combinations were marked
+   * @param infeasible indices of the infeasible combinations
+   * @return int status code (see documentation)
+   */
+  int write(const std::string &filename, const std::string &modelsFile,
+            const DICTIONARY &d, const COVERAGE &coverage,
+            const std::vector<std::size_t> &infeasible) const;
+
+private:
+  /**
+   * @brief Writes the report as JSON
+   *
+   * @param out stream to write to
+   * @param modelsFile name of the checked .models file
+   * @param d dictionary containing the compiled problem
+   * @param coverage bitmap of the combinations covered by the rows
+   * @param infeasible indices of the infeasible combinations
+   */
+  void print(std::ostream &out, const std::string &modelsFile,
+             const DICTIONARY &d, const COVERAGE &coverage,
+             const std::vector<std::size_t> &infeasible) const;
+
+  /**
+   * @brief Writes a string as JSON string literal
+   *
+   * @param out stream to write to
+   * @param text string to be written
+   */
+  static void printString(std::ostream &out, const std::string &text);
+
+  /**
+   * @brief Writes a combination as list of alternating category and element
+   * names, like a row of a .models file
+   *
+   * @param out stream to write to
+   * @param d dictionary containing the compiled problem
+   * @param coverage bitmap the index belongs to
+   * @param index index of the combination
+   */
+  static void printCombination(std::ostream &out, const DICTIONARY &d,
+                               const COVERAGE &coverage, std::size_t index);
+
+  /**
+   * @brief Name and duration in seconds of each finished phase
+   */
+  std::vector<std::pair<std::string, double>> m_phases;
+
+  /**
+   * @brief Name of the running phase, empty if there is none
+   */
+  std::string m_phase;
+
+  /**
+   * @brief Start time of the running phase
+   */
+  std::chrono::steady_clock::time_point m_start;
+
+  /**
+   * @brief Number of combinations each valid row covers first
+   */
+  std::vector<std::size_t> m_added;
+
+  /**
+   * @brief Status code of the row checks, see setStatus()
+   */
+  int m_status;
+};
+
+#endif
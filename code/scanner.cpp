@@ -0,0 +1,158 @@
+/**
+ * @file scanner.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for SCANNER class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "scanner.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PAIRWISE_SCANNER_X86
+#include <immintrin.h>
+#endif
+
+// Initialize the static member variables outside the class definition, the
+// scalar versions are used until choose() ran
+SCANNER::MASKS (*SCANNER::classifyBlock)(const char *) =
+    SCANNER::classifyScalar;
+std::uint64_t (*SCANNER::prefixXorMask)(std::uint64_t) =
+    SCANNER::prefixXorScalar;
+const char *SCANNER::instructionSet = "scalar";
+bool SCANNER::chosen = SCANNER::choose();
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+SCANNER::MASKS SCANNER::classify(const char *block) {
+  return classifyBlock(block);
+}
+
+std::uint64_t SCANNER::prefixXor(std::uint64_t mask) {
+  return prefixXorMask(mask);
+}
+
+const char *SCANNER::getInstructionSet() { return instructionSet; }
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper Functions                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+bool SCANNER::choose() {
+#ifdef PAIRWISE_SCANNER_X86
+  // SSE2 is part of every x86-64 processor
+  __builtin_cpu_init();
+  classifyBlock = classifySse2;
+  instructionSet = "sse2";
+  if (__builtin_cpu_supports("avx2")) {
+    classifyBlock = classifyAvx2;
+    instructionSet = "avx2";
+  }
+  if (__builtin_cpu_supports("pclmul")) {
+    prefixXorMask = prefixXorClmul;
+  }
+#endif
+  return true;
+}
+
+SCANNER::MASKS SCANNER::classifyScalar(const char *block) {
+  MASKS masks = {0, 0, 0};
+  for (int i = 0; i < 64; i++) {
+    std::uint64_t bit = std::uint64_t(1) << i;
+    if (block[i] == ',') {
+      masks.commas |= bit;
+    } else if (block[i] == '\n') {
+      masks.newlines |= bit;
+    } else if (block[i] == '"') {
+      masks.quotes |= bit;
+    }
+  }
+  return masks;
+}
+
+std::uint64_t SCANNER::prefixXorScalar(std::uint64_t mask) {
+  mask ^= mask << 1;
+  mask ^= mask << 2;
+  mask ^= mask << 4;
+  mask ^= mask << 8;
+  mask ^= mask << 16;
+  mask ^= mask << 32;
+  return mask;
+}
+
+#ifdef PAIRWISE_SCANNER_X86
+
+SCANNER::MASKS SCANNER::classifySse2(const char *block) {
+  const __m128i comma = _mm_set1_epi8(',');
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i quote = _mm_set1_epi8('"');
+  MASKS masks = {0, 0, 0};
+  for (int i = 0; i < 4; i++) {
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+    masks.commas |= std::uint64_t(std::uint16_t(
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, comma))))
+                    << (16 * i);
+    masks.newlines |= std::uint64_t(std::uint16_t(
+                          _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline))))
+                      << (16 * i);
+    masks.quotes |= std::uint64_t(std::uint16_t(
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote))))
+                    << (16 * i);
+  }
+  return masks;
+}
+
+__attribute__((target("avx2"))) SCANNER::MASKS
+SCANNER::classifyAvx2(const char *block) {
+  const __m256i comma = _mm256_set1_epi8(',');
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i quote = _mm256_set1_epi8('"');
+  MASKS masks = {0, 0, 0};
+  for (int i = 0; i < 2; i++) {
+    __m256i bytes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * i));
+    masks.commas |= std::uint64_t(std::uint32_t(
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, comma))))
+                    << (32 * i);
+    masks.newlines |=
+        std::uint64_t(std::uint32_t(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline))))
+        << (32 * i);
+    masks.quotes |= std::uint64_t(std::uint32_t(
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote))))
+                    << (32 * i);
+  }
+  return masks;
+}
+
+// Carry-less multiplication with all ones is the prefix XOR in a single
+// instruction
+__attribute__((target("pclmul"))) std::uint64_t
+SCANNER::prefixXorClmul(std::uint64_t mask) {
+  __m128i product = _mm_clmulepi64_si128(
+      _mm_set_epi64x(0, static_cast<long long>(mask)), _mm_set1_epi8(-1), 0);
+  return static_cast<std::uint64_t>(_mm_cvtsi128_si64(product));
+}
+
+#else
+
+// Only used on x86 processors
+SCANNER::MASKS SCANNER::classifySse2(const char *block) {
+  return classifyScalar(block);
+}
+
+SCANNER::MASKS SCANNER::classifyAvx2(const char *block) {
+  return classifyScalar(block);
+}
+
+std::uint64_t SCANNER::prefixXorClmul(std::uint64_t mask) {
+  return prefixXorScalar(mask);
+}
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * @file scanner.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for SCANNER class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_SCANNER
+#define PAIRWISE_SCANNER
+
+#include <cstdint>
+
+/**
+ * @brief Finds the special characters of csv files 64 bytes at a time
+ * @note Uses AVX2 if the processor supports it and SSE2 otherwise, the
+ * instruction set is chosen when the program starts. On other processors a
+ * plain loop is used.
+ */
+class SCANNER {
+public:
+  /**
+   * @brief Bit masks of a block of 64 bytes, bit i belongs to byte i
+   */
+  struct MASKS {
+    /**
+     * @brief Positions of ','
+     */
+    std::uint64_t commas;
+
+    /**
+     * @brief Positions of '\n'
+     */
+    std::uint64_t newlines;
+
+    /**
+     * @brief Positions of '"'
+     */
+    std::uint64_t quotes;
+  };
+
+  /**
+   * @brief Finds commas, newlines and quotes in a block
+   *
+   * @param block pointer to 64 readable bytes
+   * @return MASKS positions of the special characters
+   */
+  static MASKS classify(const char *block);
+
+  /**
+   * @brief Calculates for every bit the parity of all bits up to and
+   * including it
+   * @note Applied to the quote mask, this gives all bytes inside quotes
+   * (including the opening quote). Escaped quotes ("") change the state twice,
+   * so they do not affect the result.
+   *
+   * @param mask bit mask
+   * @return std::uint64_t prefix XOR of the mask
+   */
+  static std::uint64_t prefixXor(std::uint64_t mask);
+
+  /**
+   * @brief Get the name of the instruction set used by classify()
+   *
+   * @return const char* "avx2", "sse2" or "scalar"
+   */
+  static const char *getInstructionSet();
+
+private:
+  /**
+   * @brief classify() using a plain loop
+   */
+  static MASKS classifyScalar(const char *block);
+
+  /**
+   * @brief classify() using SSE2, 16 bytes per instruction
+   */
+  static MASKS classifySse2(const char *block);
+
+  /**
+   * @brief classify() using AVX2, 32 bytes per instruction
+   */
+  static MASKS classifyAvx2(const char *block);
+
+  /**
+   * @brief prefixXor() using shifts
+   */
+  static std::uint64_t prefixXorScalar(std::uint64_t mask);
+
+  /**
+   * @brief prefixXor() using a carry-less multiplication
+   */
+  static std::uint64_t prefixXorClmul(std::uint64_t mask);
+
+  /**
+   * @brief Chooses the fastest implementations the processor supports
+   *
+   * @return true once the choice is made
+   */
+  static bool choose();
+
+  /**
+   * @brief Implementation of classify() for this processor
+   */
+  static MASKS (*classifyBlock)(const char *);
+
+  /**
+   * @brief Implementation of prefixXor() for this processor
+   */
+  static std::uint64_t (*prefixXorMask)(std::uint64_t);
+
+  /**
+   * @brief Name of the instruction set used by classify()
+   */
+  static const char *instructionSet;
+
+  /**
+   * @brief Makes sure choose() runs before main()
+   */
+  static bool chosen;
+};
+
+#endif
@@ -13,6 +13,9 @@
 #include "checker.hpp"
 #include "model.hpp"
 
+// Initialize the static member variable outside the class definition
+unsigned SOLVER::seed = 0;
+
 SOLVER::SOLVER() {}
 
 SOLVER::~SOLVER() {}
@@ -21,12 +24,37 @@ SOLVER::~SOLVER() {}
 // Member Functions                                                         //
 /////////////////////////////////////////////////////////////////////////////
 int SOLVER::solve(PROBLEM *p, MODEL *m) {
+  // Collect all generated rows
+  std::vector<std::vector<std::string>> models;
+  int result = generate(p, [&models](const std::vector<std::string> &row) {
+    models.push_back(row);
+    return 0;
+  });
+  if (result) {
+    return result;
+  }
+
+  // write models to model
+  m->setModel(models);
+  return 0;
+}
+
+void SOLVER::setSeed(unsigned seed) { SOLVER::seed = seed; }
+
+int SOLVER::generate(
+    PROBLEM *p,
+    const std::function<int(const std::vector<std::string> &)> &yield) {
   // If the input contains single element categories, these have to be filtered
   // and added back to the model later.
   bool containsUselessOptions = false;
   bool containsUsefulOptions = true;
   std::vector<std::string> uselessOptions;
 
+  // A fixed seed is only set once, so that the rows still differ
+  if (seed) {
+    srand(seed);
+  }
+
   // Check problem contains valid input files
   int result = CHECKER::checkFiles(p);
   if (result = 100) {
@@ -35,6 +63,30 @@ int SOLVER::solve(PROBLEM *p, MODEL *m) {
     return result;
   }
 
+  // Find pairs that can not be covered because of the constraints
+  std::vector<std::tuple<std::string, std::string, std::string, std::string>>
+      infeasible;
+  result = CHECKER::findInfeasiblePairs(p, infeasible);
+  if (result) {
+    return result;
+  }
+  for (const auto &pair : infeasible) {
+    LOGGER_WARNING << "Warning: Pair " << std::get<0>(pair) << " "
+                   << std::get<1>(pair) << ", " << std::get<2>(pair) << " "
+                   << std::get<3>(pair)
+                   << " can not be covered by any row that complies with the "
+                      "constraints."
+                   << std::endl;
+  }
+
+  // Expressions in the constraints file are evaluated on element ids
+  DICTIONARY d;
+  result = d.build(p);
+  if (result) {
+    return result;
+  }
+  std::vector<int> ids;
+
   // Grab data from problem
   auto options = p->getOptions();
   auto constraints = p->getConstraints();
@@ -61,14 +113,12 @@ int SOLVER::solve(PROBLEM *p, MODEL *m) {
     // Check if any uselful categories remain
     if (options.empty()) {
       containsUsefulOptions = false;
-      LOGGER() << "INFO: This programm does very little if your options file "
-                   "only contains categories with one element..."
-                << std::endl;
+      LOGGER_INFO << "INFO: This programm does very little if your options "
+                     "file only contains categories with one element..."
+                  << std::endl;
     }
   }
 
-  // Create vector to store models
-  std::vector<std::vector<std::string>> models;
   // Create vector for pairs that will be deletd if row is valid
   std::vector<int> toDelete;
 
@@ -76,6 +126,16 @@ int SOLVER::solve(PROBLEM *p, MODEL *m) {
   if (containsUsefulOptions) {
     // generate unique pairs
     auto pairs = generatePairs(options);
+    // remove infeasible pairs, as no row can ever cover them
+    if (!infeasible.empty()) {
+      std::set<std::tuple<std::string, std::string, std::string, std::string>>
+          infeasibleSet(infeasible.begin(), infeasible.end());
+      pairs.erase(std::remove_if(pairs.begin(), pairs.end(),
+                                 [&infeasibleSet](const auto &pair) {
+                                   return infeasibleSet.count(pair) > 0;
+                                 }),
+                  pairs.end());
+    }
     // store current pair list for later, as pairs will later be removed
     auto allpairs = pairs;
 
@@ -86,21 +146,40 @@ int SOLVER::solve(PROBLEM *p, MODEL *m) {
       // generate row
       auto row = generateRow(options, pairs, allpairs, toDelete);
 
-      // check row is valid and add to models
+      // add uselessOptions back into the row before checking it, so that
+      // constraint violations caused by them are caught as well
+      row.insert(row.end(), uselessOptions.begin(), uselessOptions.end());
+
+      // check row is valid and hand it to the caller
       bool isValid = checkRowValid(constraints, row);
-      // bool isValid = true;
+      if (isValid && !d.getRules().empty()) {
+        isValid = d.compileRow(row, ids);
+        for (const EXPRESSION &rule : d.getRules()) {
+          if (isValid && rule.evaluate(ids) == EXPRESSION::FALSE) {
+            isValid = false;
+          }
+        }
+      }
       if (isValid) {
-        // add row to model
-        models.push_back(row);
-        // delete pairs used to create row
+        // delete pairs used to create row, starting with the highest index
+        // so that the remaining indices stay valid
+        std::sort(toDelete.rbegin(), toDelete.rend());
         for (auto iterator : toDelete) {
           pairs.erase(pairs.begin() + iterator);
         }
-
+        LOGGER_TRACE << "Row covers " << toDelete.size() << " pairs, "
+                     << pairs.size() << " pairs left" << std::endl;
+        // row is final, pass it on right away
+        result = yield(row);
+        if (result) {
+          return result;
+        }
       }
       // if row is not Valid,
       else if (isValid == false) {
         invalidRowCounter++;
+        LOGGER_TRACE << "Row violates the constraints, " << invalidRowCounter
+                     << " rejected so far" << std::endl;
       }
 
       // after 1000 invalid rows, break out of loop
@@ -109,29 +188,7 @@ int SOLVER::solve(PROBLEM *p, MODEL *m) {
       }
     }
   }
-  // add uselessOptions back into solution
-  if (containsUselessOptions) {
-    for (auto useless : uselessOptions) {
-      for (auto &row : models) {
-        // Add category and its element to uselessOptions vector
-        row.push_back(useless);
-      }
-    }
-    // remove constraints violations caused by adding uselessOptions
-    std::vector<std::vector<std::string>> invalid;
-    for (auto row : models) {
-      if (checkRowValid(constraints, row) == false) {
-        invalid.push_back(row);
-      }
-    }
-    for (auto row : invalid) {
-      models.erase(std::remove(models.begin(), models.end(), row),
-                   models.end());
-    }
-  }
 
-  // write models to model
-  m->setModel(models);
   return 0;
 }
 
@@ -180,9 +237,10 @@ std::vector<std::string> SOLVER::generateRow(
     remainingCategories.insert(option[0]);
   }
 
-  // Initialize randomizer
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  srand(seed); // Set seed for randomiser
+  // Initialize randomizer, unless a fixed seed was set
+  if (!seed) {
+    srand(std::chrono::system_clock::now().time_since_epoch().count());
+  }
 
   // add random pairs to row until no more pairs can fit
   while (remainingCategories.size() > 1) {
@@ -260,9 +318,8 @@ std::vector<std::string> SOLVER::generateRow(
       }
     }
 
-    // Choose random element from row in options
-    //int j = (rand() % (options.size() - 1)) + 1;
-    int j = (rand() % (options[i].size()));
+    // Choose random element from row in options, index 0 is the category
+    int j = (rand() % (options[i].size() - 1)) + 1;
     std::string element = options[i][j];
 
     // Add category & element to output row
@@ -277,6 +334,10 @@ bool SOLVER::checkRowValid(
     const std::vector<std::vector<std::string>> &constraints,
     std::vector<std::string> &row) {
   for (const std::vector<std::string> &constraint : constraints) {
+    // Expressions are checked by the caller, see solve()
+    if (EXPRESSION::isExpression(constraint)) {
+      continue;
+    }
     std::unordered_set<std::string> constraintSet;
     for (size_t i = 0; i < constraint.size(); i += 2) {
       // Collecting pairs of category names and respective elements from
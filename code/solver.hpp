@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdlib>
+#include <functional>
+#include <set>
 #include <tuple>
 #include <unordered_set>
 
@@ -45,6 +47,32 @@ public:
    */
   static int solve(PROBLEM *p, MODEL *m);
 
+  /**
+   * @brief Generate possible solutions to the Problem and pass each row to
+   * the caller as soon as it is final
+   * @note Rows are passed in the same order in which solve() stores them.
+   * This allows the caller to write out or check rows while the solver is
+   * still running.
+   *
+   * @param p Pointer to instance of PROBLEM class with required data for
+   * solving
+   * @param yield function which receives each row, if it returns a status
+   * code other than 0, generation stops and the status code is returned
+   * @return int status code (see documentation)
+   */
+  static int
+  generate(PROBLEM *p,
+           const std::function<int(const std::vector<std::string> &)> &yield);
+
+  /**
+   * @brief Sets the seed of the random number generator, so that the same
+   * problem always leads to the same rows (e.g. for tests)
+   *
+   * @param seed seed passed to srand() once per generate(), 0 seeds every
+   * row from the clock (default)
+   */
+  static void setSeed(unsigned seed);
+
   friend bool testGeneratePairs();
   friend bool testGenerateRow();
   friend bool testCheckRowValid();
@@ -88,6 +116,7 @@ private:
 
   /**
    * @brief Checks if a row complies with all constraints
+   * @note Expressions are skipped, they are evaluated on element ids
    *
    * @param constraints vector containing constraints to check against
    * @param row vector containing row to be checked
@@ -97,6 +126,11 @@ private:
   static bool
   checkRowValid(const std::vector<std::vector<std::string>> &constraints,
                 std::vector<std::string> &row);
+
+  /**
+   * @brief Seed of the random number generator, 0 if the clock is used
+   */
+  static unsigned seed;
 };
 
 #endif
\ No newline at end of file
@@ -12,32 +12,80 @@
 #include "model.hpp"
 #include "problem.hpp"
 #include "logger.hpp"
+#include "prettyPrint.hpp"
+#include "writer.hpp"
 #include <iostream>
+#include <string>
+#include <vector>
 
 /**
  * @brief Main function for solverMain program
  *
  * @param argc argument count
  * @param argv argument values
+ * @arg \c --stream (optional) write each row as soon as it is generated, use
+ * "-" as modelsFile to write to stdout
+ * @arg \c --pipeline (optional) check and write the rows on separate threads
+ * while solving, without keeping them in memory. Use "-" as modelsFile to
+ * write to stdout
+ * @arg \c --sync (optional) sync the models file to disk before it replaces
+ * an existing file
+ * @arg \c --sort (optional) sort the rows by their elements, the categories
+ * of every row are always printed in the order of the options. Can not be
+ * combined with --stream or --pipeline, which write rows while solving
+ * @arg \c --log (optional) followed by the lowest level of log messages
+ * printed, "trace", "debug", "info", "warning" or "off" (see LOGGER)
  * @arg \c optionsFile Filename for .options file
  * @arg \c constraintsFile Filename for .constraints file
- * @arg \c modelsFile Filename for .models file
+ * @arg \c modelsFile Filename for .models file, "-" for stdout
  * @return \c int status code (see documentation)
  */
 int main(int argc, char **argv) {
-  //Set this to true to enable verbose logging to console
-  LOGGER::SetVerboseMode(false);
+  // Only warnings are printed unless PAIRWISE_LOG or --log name a level
+  LOGGER::configure();
+
+  // Separate optional flags from filenames
+  bool streamMode = false;
+  bool pipelineMode = false;
+  bool sortRows = false;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    if (argument == "--stream") {
+      streamMode = true;
+    } else if (argument == "--pipeline") {
+      pipelineMode = true;
+    } else if (argument == "--sync") {
+      WRITER::setSync(true);
+    } else if (argument == "--sort") {
+      sortRows = true;
+    } else if (argument == "--log" && i + 1 < argc) {
+      if (!LOGGER::setLevel(argv[++i])) {
+        std::cout << "Unknown log level: " << argv[i] << std::endl;
+        return 20;
+      }
+    } else {
+      files.push_back(argument);
+    }
+  }
+
+  // Rows can only be sorted once all of them were generated
+  if (sortRows && (streamMode || pipelineMode)) {
+    std::cout << "--sort can not be combined with --stream or --pipeline"
+              << std::endl;
+    return 10;
+  }
 
   // Check if correct number of arguments were supplied
-  if (argc != 4) {
+  if (files.size() != 3) {
     std::cout << "Invalid number of arguments supplied" << std::endl;
     return 10;
   }
 
   // Create instance of problem and model class using given file locations /
   // arguments
-  PROBLEM problem = PROBLEM(argv[1], argv[2]);
-  MODEL model = MODEL(&problem, argv[3]);
+  PROBLEM problem = PROBLEM(files[0], files[1]);
+  MODEL model = MODEL(&problem, files[2]);
 
   // Parse problem
   int parseProblem = problem.parse();
@@ -45,19 +93,44 @@ int main(int argc, char **argv) {
     return 10;
   }
 
+  // In stream and pipeline mode rows are printed while solving
+  if (streamMode || pipelineMode) {
+    int streamModel = pipelineMode ? model.pipeline() : model.stream();
+    if (streamModel == 10) {
+      return 10;
+    }
+    if (streamModel == 20 || streamModel == 30) {
+      return 20;
+    }
+    // stdout only contains the model in this case
+    if (files[2] != "-") {
+      std::cout << "\033[1;32mCOMPLETE\033[0m\n";
+    }
+    return 0;
+  }
+
   // Solve Model (Function has integrated check)
   int solveModel = model.solve();
   if (solveModel == 20 || solveModel == 30) {
     return 20;
   }
 
+  // Put the rows in a canonical order, so that the same model always gives
+  // the same file
+  int sortModel = PRETTYPRINT::sort(&model, sortRows);
+  if (sortModel) {
+    return sortModel;
+  }
+
   // Print Model
   int printModel = model.print();
   if (printModel) {
     return 10;
   }
 
-  std::cout << "\033[1;32mCOMPLETE\033[0m\n";
+  if (files[2] != "-") {
+    std::cout << "\033[1;32mCOMPLETE\033[0m\n";
+  }
 
   return 0;
-}
\ No newline at end of file
+}
@@ -10,8 +10,12 @@
  */
 
 #include "solver.hpp"
+#include "memory.hpp"
 #include "model.hpp"
+#include "pipeline.hpp"
+#include "prettyPrint.hpp"
 
+#include <cstdio>
 #include <unordered_map>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -435,6 +439,271 @@ bool testSolver() {
   }
   std::cout << "\033[1;32mPASSED\033[0m\n";
 
+  // Test solving while checking and writing the rows on other threads
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsValid);
+  m->setModelsFile("solverTestPipeline.models");
+  std::cout << "Testing with problem 2 in pipeline mode: " << std::endl;
+  result = m->pipeline();
+  // the rows are only in the file, read them back and check them again
+  if (result == 0 && m->getModels().empty()) {
+    result = m->parse();
+  }
+  if (result == 0) {
+    result = m->check();
+  }
+  // The categories of each row are written in the order of the options
+  for (const std::vector<std::string> &row : m->getModels()) {
+    if (row.size() != 6 || row[0] + row[2] + row[4] !=
+                                "CategoryACategoryBCategoryC") {
+      result = 50;
+    }
+  }
+  std::remove("solverTestPipeline.models");
+  if (result != 0 || m->getModels().empty()) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test sorting a solution, categories follow the options and the rows are
+  // in ascending order of their elements
+  p->setOptions(optionsBarelyValid);
+  p->setConstraints(constraintsValid);
+  std::cout << "Testing sorted solution of problem 3: " << std::endl;
+  result = m->solve();
+  if (result == 0) {
+    result = PRETTYPRINT::sort(m, true);
+  }
+  std::vector<std::string> previous;
+  for (const std::vector<std::string> &row : m->getModels()) {
+    if (row.size() != 6 || row[0] + row[2] + row[4] !=
+                                "CategoryACategoryBCategoryC") {
+      result = 50;
+      break;
+    }
+    // Element names of these options sort like their positions
+    std::vector<std::string> elements = {row[1], row[3], row[5]};
+    if (elements < previous) {
+      result = 50;
+    }
+    previous = elements;
+  }
+  if (result == 0) {
+    result = m->check();
+  }
+  if ((result != 0) && (result != 100)) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests the SOLVER::generate() function and MODEL::stream()
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testGenerate() {
+  PROBLEM test = PROBLEM("test", "test"); // Sample problem
+  PROBLEM *p = &test;                     // Pointer to sample problem
+  int result;                             // Temporarily stores result
+  MODEL testModel = MODEL(p, "test");     // Sample model
+  MODEL *m = &testModel;                  // Pointer to test model
+
+  std::vector<std::vector<std::string>> optionsValid = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB", "ElementC"},
+      {"CategoryC", "ElementX", "ElementY", "ElementZ"}};
+
+  std::vector<std::vector<std::string>> optionsBarelyValid = {
+      {"CategoryA", "Element1"},
+      {"CategoryB", "ElementA", "ElementB", "ElementC"},
+      {"CategoryC", "ElementX", "ElementY", "ElementZ"}};
+
+  std::vector<std::vector<std::string>> constraintsEmpty = {};
+
+  std::vector<std::vector<std::string>> constraintsValid = {
+      {"CategoryA", "Element1", "CategoryC", "ElementX", "CategoryB",
+       "ElementA"},
+      {"CategoryB", "ElementB", "CategoryA", "Element1", "CategoryC",
+       "ElementZ"},
+      {"CategoryA", "Element1", "CategoryC", "ElementY", "CategoryB",
+       "ElementC"}};
+
+  std::vector<std::pair<std::vector<std::vector<std::string>>,
+                        std::vector<std::vector<std::string>>>>
+      problems = {{optionsValid, constraintsEmpty},
+                  {optionsValid, constraintsValid},
+                  {optionsBarelyValid, constraintsValid}};
+
+  // Test that generate() passes the rows of solve() in the same order, with
+  // the same seed both draw the same rows
+  for (std::size_t i = 0; i < problems.size(); i++) {
+    p->setOptions(problems[i].first);
+    p->setConstraints(problems[i].second);
+    std::cout << "Testing generated rows of problem " << i + 1 << ": "
+              << std::endl;
+    SOLVER::setSeed(42);
+    result = SOLVER::solve(p, m);
+    std::vector<std::vector<std::string>> generated;
+    SOLVER::setSeed(42);
+    if (result == 0) {
+      result = SOLVER::generate(p, [&generated](
+                                       const std::vector<std::string> &row) {
+        generated.push_back(row);
+        return 0;
+      });
+    }
+    SOLVER::setSeed(0);
+    if (result != 0 || generated.empty() || generated != m->getModels()) {
+      std::cout << "\033[1;31mFAILED\033[0m\n";
+      return false;
+    }
+    std::cout << "\033[1;32mPASSED\033[0m\n";
+  }
+
+  // Test that a status returned by the callback stops the generation
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsValid);
+  std::cout << "Testing generation stopped by the callback: " << std::endl;
+  int calls = 0;
+  result = SOLVER::generate(p, [&calls](const std::vector<std::string> &) {
+    calls++;
+    return 10;
+  });
+  if (result != 10 || calls != 1) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test that streamed rows are written like the sorted rows of solve()
+  std::cout << "Testing streamed rows of problem 2: " << std::endl;
+  SOLVER::setSeed(42);
+  result = m->solve();
+  if (result == 0) {
+    result = PRETTYPRINT::sort(m);
+  }
+  m->setModelsFile("mem:solverTestSolve.models");
+  if (result == 0) {
+    result = m->print();
+  }
+  SOLVER::setSeed(42);
+  m->setModelsFile("mem:solverTestStream.models");
+  if (result == 0) {
+    result = m->stream();
+  }
+  SOLVER::setSeed(0);
+  std::string solved, streamed;
+  if (!MEMORY::read("mem:solverTestSolve.models", solved) ||
+      !MEMORY::read("mem:solverTestStream.models", streamed)) {
+    result = 10;
+  }
+  MEMORY::remove("mem:solverTestSolve.models");
+  MEMORY::remove("mem:solverTestStream.models");
+  if (result != 0 || solved.empty() || solved != streamed) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  return true;
+}
+
+/**
+ * @brief tests the PIPELINE::run() function
+ *
+ * @return true if tests pass
+ * @return false if tests fail
+ */
+bool testPipeline() {
+  PROBLEM test = PROBLEM("test", "test"); // Sample problem
+  PROBLEM *p = &test;                     // Pointer to sample problem
+  int result;                             // Temporarily stores result
+  MODEL testModel = MODEL(p, "test");     // Sample model
+  MODEL *m = &testModel;                  // Pointer to test model
+
+  std::vector<std::vector<std::string>> optionsValid = {
+      {"CategoryA", "Element1", "Element2"},
+      {"CategoryB", "ElementA", "ElementB", "ElementC"},
+      {"CategoryC", "ElementX", "ElementY", "ElementZ"}};
+
+  std::vector<std::vector<std::string>> constraintsValid = {
+      {"CategoryA", "Element1", "CategoryC", "ElementX", "CategoryB",
+       "ElementA"},
+      {"CategoryB", "ElementB", "CategoryA", "Element1", "CategoryC",
+       "ElementZ"},
+      {"CategoryA", "Element1", "CategoryC", "ElementY", "CategoryB",
+       "ElementC"}};
+
+  std::vector<std::vector<std::string>> constraintsInvalid = {
+      {"CategoryA", "Element1", "CategoryD", "ElementX"}};
+
+  // Test that the pipeline writes the same bytes as solve() followed by
+  // print(), with the same seed both draw the same rows
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsValid);
+  std::cout << "Testing pipeline output of problem 2: " << std::endl;
+  SOLVER::setSeed(42);
+  result = m->solve();
+  if (result == 0) {
+    result = PRETTYPRINT::sort(m);
+  }
+  m->setModelsFile("mem:solverTestSolve.models");
+  if (result == 0) {
+    result = m->print();
+  }
+  SOLVER::setSeed(42);
+  m->setModelsFile("mem:solverTestPipeline.models");
+  if (result == 0) {
+    result = PIPELINE::run(m);
+  }
+  SOLVER::setSeed(0);
+  std::string solved, pipelined;
+  if (!MEMORY::read("mem:solverTestSolve.models", solved) ||
+      !MEMORY::read("mem:solverTestPipeline.models", pipelined)) {
+    result = 10;
+  }
+  MEMORY::remove("mem:solverTestSolve.models");
+  MEMORY::remove("mem:solverTestPipeline.models");
+  if (result != 0 || solved.empty() || solved != pipelined) {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test that the checker stops the pipeline with its status when it can not
+  // check the rows, the existing file is kept
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsValid);
+  MEMORY::write("mem:solverTestPipeline.models", "previous");
+  std::cout << "Testing pipeline stopped by the checker: " << std::endl;
+  result = PIPELINE::run(m, 0);
+  MEMORY::read("mem:solverTestPipeline.models", pipelined);
+  if (result != 50 || pipelined != "previous") {
+    MEMORY::remove("mem:solverTestPipeline.models");
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
+
+  // Test with an invalid problem, the status of the constraints check is
+  // returned and the existing file is kept
+  p->setOptions(optionsValid);
+  p->setConstraints(constraintsInvalid);
+  std::cout << "Testing pipeline with invalid problem: " << std::endl;
+  result = PIPELINE::run(m);
+  MEMORY::read("mem:solverTestPipeline.models", pipelined);
+  MEMORY::remove("mem:solverTestPipeline.models");
+  if (result != 30 || pipelined != "previous") {
+    std::cout << "\033[1;31mFAILED\033[0m\n";
+    return false;
+  }
+  std::cout << "\033[1;32mPASSED\033[0m\n";
 
   return true;
 }
@@ -490,7 +759,23 @@ int main() {
 
   std::cout << "-------------------------------------" << std::endl;
 
-  std::cout << "Testing complete, passed " << counter << " of 4 test groups"
+  std::cout << "Starting test of generate()" << std::endl;
+  input = testGenerate();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Starting test of PIPELINE::run()" << std::endl;
+  input = testPipeline();
+  if (input) {
+    counter++;
+  }
+
+  std::cout << "-------------------------------------" << std::endl;
+
+  std::cout << "Testing complete, passed " << counter << " of 6 test groups"
             << std::endl;
   return 0;
 }
\ No newline at end of file
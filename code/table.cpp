@@ -0,0 +1,203 @@
+/**
+ * @file table.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for TABLE and FIELDS classes
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "table.hpp"
+#include "compression.hpp"
+#include "logger.hpp"
+#include "memory.hpp"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+FIELDS::FIELDS(const std::string_view *begin, const std::string_view *end)
+    : m_begin{begin}, m_end{end} {}
+
+FIELDS::~FIELDS() {}
+
+TABLE::TABLE() : m_mapping{nullptr}, m_status{0}, m_scanned{0} {}
+
+TABLE::~TABLE() {
+  if (m_mapping) {
+    munmap(m_mapping, m_data.size());
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+std::size_t FIELDS::size() const { return m_end - m_begin; }
+
+const std::string_view &FIELDS::operator[](std::size_t index) const {
+  return m_begin[index];
+}
+
+const std::string_view *FIELDS::begin() const { return m_begin; }
+
+const std::string_view *FIELDS::end() const { return m_end; }
+
+int TABLE::map(const std::string &filename) {
+  // Read stdin into buffer, it can not be mapped
+  if (filename == "-") {
+    m_buffer.assign(std::istreambuf_iterator<char>(std::cin),
+                    std::istreambuf_iterator<char>());
+    m_data = m_buffer;
+    return decompress(filename);
+  }
+
+  // Memory files are copied, the original may be replaced while reading
+  if (MEMORY::isMemory(filename)) {
+    if (!MEMORY::read(filename, m_buffer)) {
+      LOGGER_INFO << "Error opening file: " << filename << std::endl;
+      return 10;
+    }
+    m_data = m_buffer;
+    return decompress(filename);
+  }
+
+  int file = open(filename.c_str(), O_RDONLY);
+  if (file < 0) {
+    LOGGER_INFO << "Error opening file: " << filename << std::endl;
+    return 10;
+  }
+  struct stat info;
+  if (fstat(file, &info) || !S_ISREG(info.st_mode)) {
+    close(file);
+    LOGGER_INFO << "Error opening file: " << filename << std::endl;
+    return 10;
+  }
+
+  // Empty files can not be mapped, there is nothing to read anyway
+  if (info.st_size > 0) {
+    void *mapping =
+        mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (mapping == MAP_FAILED) {
+      close(file);
+      LOGGER_INFO << "Error mapping file: " << filename << std::endl;
+      return 10;
+    }
+    // The file is read once from start to end
+    madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+    m_mapping = static_cast<char *>(mapping);
+    m_data = std::string_view(m_mapping, info.st_size);
+  }
+  close(file);
+  return decompress(filename);
+}
+
+std::string_view TABLE::getData() const { return m_data; }
+
+void TABLE::addField(std::string_view field) { m_fields.push_back(field); }
+
+void TABLE::addString(std::string field) {
+  if (m_strings.empty()) {
+    m_strings.emplace_back();
+  }
+  m_strings.back().push_back(std::move(field));
+  m_fields.push_back(m_strings.back().back());
+}
+
+void TABLE::endRow(std::size_t next) {
+  m_rowEnds.push_back(m_fields.size());
+  if (next) {
+    m_scanned = next;
+  }
+
+  // Hand row to visitor and forget it again
+  if (m_visitor) {
+    if (!m_status) {
+      m_status = m_visitor((*this)[0]);
+    }
+    m_fields.clear();
+    m_rowEnds.clear();
+    m_strings.clear();
+  }
+}
+
+void TABLE::setVisitor(std::function<int(const FIELDS &)> visitor) {
+  m_visitor = visitor;
+}
+
+int TABLE::getStatus() const { return m_status; }
+
+std::size_t TABLE::getScanned() const { return m_scanned; }
+
+void TABLE::clearRows() {
+  m_fields.clear();
+  m_rowEnds.clear();
+  m_strings.clear();
+  m_status = 0;
+  m_scanned = 0;
+}
+
+void TABLE::append(TABLE &part) {
+  std::size_t offset = m_fields.size();
+  m_fields.insert(m_fields.end(), part.m_fields.begin(), part.m_fields.end());
+  for (std::size_t end : part.m_rowEnds) {
+    m_rowEnds.push_back(offset + end);
+  }
+
+  m_scanned = std::max(m_scanned, part.m_scanned);
+
+  // Moving a deque keeps its strings in place, so the fields stay valid
+  for (auto &strings : part.m_strings) {
+    m_strings.push_back(std::move(strings));
+  }
+
+  part.clearRows();
+}
+
+bool TABLE::isRowOpen() const {
+  return m_fields.size() > (m_rowEnds.empty() ? 0 : m_rowEnds.back());
+}
+
+std::size_t TABLE::size() const { return m_rowEnds.size(); }
+
+FIELDS TABLE::operator[](std::size_t row) const {
+  std::size_t begin = row ? m_rowEnds[row - 1] : 0;
+  return FIELDS(m_fields.data() + begin, m_fields.data() + m_rowEnds[row]);
+}
+
+std::vector<std::vector<std::string>> TABLE::toVector() const {
+  std::vector<std::vector<std::string>> rows;
+  rows.reserve(size());
+  for (std::size_t i = 0; i < size(); i++) {
+    FIELDS fields = (*this)[i];
+    rows.emplace_back(fields.begin(), fields.end());
+  }
+  return rows;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper Functions                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+int TABLE::decompress(const std::string &filename) {
+  if (!COMPRESSION::isCompressed(m_data)) {
+    return 0;
+  }
+
+  // Replace the compressed contents by the decompressed ones
+  std::string decompressed;
+  int status = COMPRESSION::decompress(filename, m_data, decompressed);
+  if (m_mapping) {
+    munmap(m_mapping, m_data.size());
+    m_mapping = nullptr;
+  }
+  m_buffer = std::move(decompressed);
+  m_data = m_buffer;
+  return status;
+}
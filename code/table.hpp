@@ -0,0 +1,262 @@
+/**
+ * @file table.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for TABLE and FIELDS classes
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_TABLE
+#define PAIRWISE_TABLE
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Read-only view of the fields of one csv row
+ * @note Only valid as long as the TABLE it was taken from exists
+ */
+class FIELDS {
+public:
+  /**
+   * @brief Construct a new FIELDS object
+   *
+   * @param begin pointer to the first field
+   * @param end pointer behind the last field
+   */
+  FIELDS(const std::string_view *begin, const std::string_view *end);
+  ~FIELDS();
+
+  /**
+   * @brief Get the number of fields
+   *
+   * @return std::size_t number of fields
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Get a field
+   *
+   * @param index index of the field
+   * @return const std::string_view& contents of the field
+   */
+  const std::string_view &operator[](std::size_t index) const;
+
+  /**
+   * @brief Get a pointer to the first field, used for range-based for loops
+   *
+   * @return const std::string_view* pointer to the first field
+   */
+  const std::string_view *begin() const;
+
+  /**
+   * @brief Get a pointer behind the last field
+   *
+   * @return const std::string_view* pointer behind the last field
+   */
+  const std::string_view *end() const;
+
+private:
+  /**
+   * @brief Pointer to the first field
+   */
+  const std::string_view *m_begin;
+
+  /**
+   * @brief Pointer behind the last field
+   */
+  const std::string_view *m_end;
+};
+
+/**
+ * @brief Contents of a csv file that is mapped into memory, stored as
+ * string_views into the mapped file instead of copies
+ * @note Only fields that had to be unescaped are stored as separate strings.
+ * The mapping is released when the table is destroyed.
+ */
+class TABLE {
+public:
+  TABLE();
+  ~TABLE();
+
+  // The fields point into the mapping, so copying is not allowed
+  TABLE(const TABLE &) = delete;
+  TABLE &operator=(const TABLE &) = delete;
+
+  /**
+   * @brief Maps a file into memory, the rows have to be added afterwards
+   * (see PARSER)
+   * @note If the file can not be mapped (e.g. "-" for stdin), it is read into
+   * a buffer instead. Compressed files (see COMPRESSION) are decompressed
+   * into the buffer.
+   *
+   * @param filename name of the file
+   * @return int status code (see documentation)
+   */
+  int map(const std::string &filename);
+
+  /**
+   * @brief Get the contents of the mapped file
+   *
+   * @return std::string_view contents of the file
+   */
+  std::string_view getData() const;
+
+  /**
+   * @brief Appends a field to the current row
+   *
+   * @param field contents of the field, must point into getData() or be
+   * stored with addString()
+   */
+  void addField(std::string_view field);
+
+  /**
+   * @brief Stores an unescaped field and appends it to the current row
+   *
+   * @param field contents of the field
+   */
+  void addString(std::string field);
+
+  /**
+   * @brief Ends the current row, the next field starts a new one
+   * @note If a visitor is set, the row is handed to it and removed again
+   *
+   * @param next byte offset behind the newline ending the row, 0 if the row
+   * ends at the end of the file
+   */
+  void endRow(std::size_t next = 0);
+
+  /**
+   * @brief Hands every row to a function as soon as it is complete instead
+   * of storing it, so the table only ever holds a single row
+   *
+   * @param visitor function called with each row, a return value other than
+   * 0 stops the scan (see getStatus())
+   */
+  void setVisitor(std::function<int(const FIELDS &)> visitor);
+
+  /**
+   * @brief Get the first return value of the visitor other than 0
+   *
+   * @return int return value of the visitor, 0 if all rows were accepted
+   */
+  int getStatus() const;
+
+  /**
+   * @brief Get the byte offset behind the last row that ended with a newline
+   *
+   * @return std::size_t byte offset, 0 if there is no such row
+   */
+  std::size_t getScanned() const;
+
+  /**
+   * @brief Removes all rows and resets getStatus() and getScanned(), the
+   * mapping is kept
+   */
+  void clearRows();
+
+  /**
+   * @brief Moves all rows of another table behind the rows of this one
+   * @note Used to combine tables that were filled on separate threads, the
+   * fields of part have to point into the file mapped by this table. part is
+   * empty afterwards.
+   *
+   * @param part table containing the following rows
+   */
+  void append(TABLE &part);
+
+  /**
+   * @brief Checks if fields were added since the last call of endRow()
+   *
+   * @return true if the current row contains fields
+   * @return false otherwise
+   */
+  bool isRowOpen() const;
+
+  /**
+   * @brief Get the number of rows
+   *
+   * @return std::size_t number of rows
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Get the fields of a row
+   *
+   * @param row index of the row
+   * @return FIELDS fields of the row
+   */
+  FIELDS operator[](std::size_t row) const;
+
+  /**
+   * @brief Copies the table to a vector of rows
+   *
+   * @return std::vector<std::vector<std::string>> copy of the table
+   */
+  std::vector<std::vector<std::string>> toVector() const;
+
+private:
+  /**
+   * @brief Replaces compressed contents of the table by the decompressed
+   * contents
+   *
+   * @param filename name of the file, used for error messages
+   * @return int status code (see documentation), 10 if the file is damaged
+   */
+  int decompress(const std::string &filename);
+
+  /**
+   * @brief Start of the mapped file, nullptr if the file is stored in
+   * #m_buffer
+   */
+  char *m_mapping;
+
+  /**
+   * @brief Contents of the file if it could not be mapped or was compressed
+   */
+  std::string m_buffer;
+
+  /**
+   * @brief Contents of the file, points to #m_mapping or #m_buffer
+   */
+  std::string_view m_data;
+
+  /**
+   * @brief Fields of all rows
+   */
+  std::vector<std::string_view> m_fields;
+
+  /**
+   * @brief Index in #m_fields behind the last field of each row
+   */
+  std::vector<std::size_t> m_rowEnds;
+
+  /**
+   * @brief Fields that had to be unescaped, a deque keeps them in place when
+   * new ones are added. Appended tables bring their own deque.
+   */
+  std::vector<std::deque<std::string>> m_strings;
+
+  /**
+   * @brief Function receiving the rows, rows are stored if it is empty
+   */
+  std::function<int(const FIELDS &)> m_visitor;
+
+  /**
+   * @brief First return value of #m_visitor other than 0
+   */
+  int m_status;
+
+  /**
+   * @brief Byte offset behind the last row that ended with a newline
+   */
+  std::size_t m_scanned;
+};
+
+#endif
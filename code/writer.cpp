@@ -0,0 +1,216 @@
+/**
+ * @file writer.cpp
+ * @author Max Heinekamp
+ * @brief Contains function definitions for WRITER class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "writer.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Initialize the static member variables outside the class definition
+const std::size_t WRITER::bufferSize = 1 << 20;
+bool WRITER::syncEnabled = false;
+
+WRITER::WRITER(const std::string &filename, bool direct)
+    : std::ostream(nullptr), m_filename(filename), m_file(-1) {
+  rdbuf(&m_buffer);
+
+  // Devices and pipes can not be replaced, they are written directly
+  struct stat status;
+  if (direct) {
+    m_file = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0666);
+  } else if (stat(filename.c_str(), &status) == 0 &&
+             !S_ISREG(status.st_mode)) {
+    m_file = open(filename.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+  } else {
+    m_temporary = filename + "." + std::to_string(getpid()) + ".tmp";
+    m_file = open(m_temporary.c_str(),
+                  O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  }
+  m_buffer.setFile(m_file);
+  if (m_file < 0) {
+    setstate(std::ios::badbit);
+  }
+}
+
+WRITER::~WRITER() {
+  m_buffer.setFile(-1);
+  if (m_file >= 0) {
+    close(m_file);
+    if (!m_temporary.empty()) {
+      unlink(m_temporary.c_str());
+    }
+  }
+}
+
+WRITER::BUFFER::BUFFER() : m_file(-1), m_data(new char[WRITER::bufferSize]) {
+  setp(m_data.get(), m_data.get() + WRITER::bufferSize);
+}
+
+WRITER::BUFFER::~BUFFER() {}
+
+///////////////////////////////////////////////////////////////////////////////
+// Function Definitions                                                     //
+/////////////////////////////////////////////////////////////////////////////
+
+void WRITER::setSync(bool enabled) { syncEnabled = enabled; }
+
+bool WRITER::is_open() const { return m_file >= 0; }
+
+bool WRITER::finish() {
+  if (m_file < 0) {
+    return false;
+  }
+
+  bool written = bool(flush());
+  if (written && syncEnabled && fsync(m_file) != 0) {
+    written = false;
+  }
+  m_buffer.setFile(-1);
+  if (close(m_file) != 0) {
+    written = false;
+  }
+  m_file = -1;
+  if (m_temporary.empty()) {
+    return written;
+  }
+
+  // Keep the previous file if anything went wrong
+  if (!written || std::rename(m_temporary.c_str(), m_filename.c_str()) != 0) {
+    unlink(m_temporary.c_str());
+    setstate(std::ios::badbit);
+    return false;
+  }
+
+  // The rename itself is only durable once the directory is synced
+  if (syncEnabled) {
+    std::size_t slash = m_filename.rfind('/');
+    std::string directory =
+        slash == std::string::npos ? "." : m_filename.substr(0, slash + 1);
+    int file = open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file >= 0) {
+      fsync(file);
+      close(file);
+    }
+  }
+  return true;
+}
+
+bool WRITER::reserve(std::size_t size, std::size_t &offset) {
+  struct stat status;
+  if (m_file < 0 || !flush() || fstat(m_file, &status) != 0 ||
+      !S_ISREG(status.st_mode)) {
+    return false;
+  }
+  off_t position = lseek(m_file, 0, SEEK_CUR);
+  if (position < 0) {
+    return false;
+  }
+
+  // Some file systems can not allocate space, the file is extended instead
+  if (size > 0 && posix_fallocate(m_file, position, size) != 0 &&
+      ftruncate(m_file, position + size) != 0) {
+    return false;
+  }
+  if (lseek(m_file, position + size, SEEK_SET) < 0) {
+    return false;
+  }
+  offset = position;
+  return true;
+}
+
+bool WRITER::writeAt(const char *data, std::size_t size, std::size_t offset) {
+  while (size > 0) {
+    ssize_t written = pwrite(m_file, data, size, offset);
+    if (written <= 0) {
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= written;
+    offset += written;
+  }
+  return true;
+}
+
+void WRITER::BUFFER::setFile(int file) { m_file = file; }
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper Functions                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+WRITER::BUFFER::int_type WRITER::BUFFER::overflow(int_type c) {
+  if (!drain(nullptr, 0)) {
+    return traits_type::eof();
+  }
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+std::streamsize WRITER::BUFFER::xsputn(const char *s, std::streamsize n) {
+  if (n <= epptr() - pptr()) {
+    std::memcpy(pptr(), s, n);
+    pbump(n);
+    return n;
+  }
+  return drain(s, n) ? n : 0;
+}
+
+int WRITER::BUFFER::sync() { return drain(nullptr, 0) ? 0 : -1; }
+
+bool WRITER::BUFFER::drain(const char *data, std::size_t size) {
+  if (m_file < 0) {
+    return false;
+  }
+  iovec blocks[2] = {{pbase(), std::size_t(pptr() - pbase())},
+                     {const_cast<char *>(data), size}};
+  bool written = writeBlocks(blocks, data ? 2 : 1);
+  setp(m_data.get(), m_data.get() + WRITER::bufferSize);
+  return written;
+}
+
+bool WRITER::BUFFER::writeBlocks(iovec *blocks, int count) {
+  while (count > 0) {
+    if (blocks->iov_len == 0) {
+      blocks++;
+      count--;
+      continue;
+    }
+    ssize_t written = writev(m_file, blocks, count);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    // Skip the blocks that were written completely
+    while (count > 0 && std::size_t(written) >= blocks->iov_len) {
+      written -= blocks->iov_len;
+      blocks++;
+      count--;
+    }
+    if (count > 0) {
+      blocks->iov_base = static_cast<char *>(blocks->iov_base) + written;
+      blocks->iov_len -= written;
+    }
+  }
+  return true;
+}
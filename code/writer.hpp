@@ -0,0 +1,206 @@
+/**
+ * @file writer.hpp
+ * @author Max Heinekamp
+ * @brief Contains declarations for WRITER class
+ * @version 1.0
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PAIRWISE_WRITER
+#define PAIRWISE_WRITER
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+#include <sys/uio.h>
+
+/**
+ * @brief Output stream writing a file in large blocks through a temporary
+ * file
+ * @note The data is written to a temporary file next to the target, which
+ * only replaces the target when finish() is called. Readers therefore see
+ * either the old or the complete new file. If the stream is destroyed
+ * without finish(), e.g. after an error, the temporary file is removed.
+ * Targets that exist but are not regular files (e.g. /dev/null or a pipe)
+ * are written directly.
+ */
+class WRITER : public std::ostream {
+public:
+  /**
+   * @brief Size of the buffer, larger writes bypass it
+   */
+  static const std::size_t bufferSize;
+
+  /**
+   * @brief Enables writing files to disk with fsync before they replace
+   * their target
+   *
+   * @param enabled true to sync files, false by default
+   */
+  static void setSync(bool enabled);
+
+  /**
+   * @brief Creates the temporary file for a target
+   *
+   * @param filename Filename of the target
+   * @param direct true to write the target directly, so that readers can
+   * follow the file while it is written
+   */
+  WRITER(const std::string &filename, bool direct = false);
+
+  /**
+   * @brief Removes the temporary file if finish() was not called
+   */
+  ~WRITER();
+
+  /**
+   * @brief Checks if the file could be opened
+   *
+   * @return true if the file is open
+   * @return false otherwise
+   */
+  bool is_open() const;
+
+  /**
+   * @brief Writes the remaining data and replaces the target with the
+   * temporary file
+   *
+   * @return true if all data was written
+   * @return false otherwise, the target is left unchanged
+   */
+  bool finish();
+
+  /**
+   * @brief Reserves space behind the data written so far for writeAt(), the
+   * stream continues behind the reserved space
+   * @note Only works for regular files, the space is allocated on disk so
+   * that it does not run out halfway.
+   *
+   * @param size size of the reserved space
+   * @param offset receives the position of the reserved space in the file
+   * @return true if the space was reserved
+   * @return false otherwise, nothing was changed
+   */
+  bool reserve(std::size_t size, std::size_t &offset);
+
+  /**
+   * @brief Writes a block at a position inside space reserved by reserve()
+   * @note Bypasses the buffer, so several threads may write different parts
+   * of the reserved space at the same time.
+   *
+   * @param data block to be written
+   * @param size size of the block
+   * @param offset position in the file
+   * @return true if the block was written
+   * @return false otherwise
+   */
+  bool writeAt(const char *data, std::size_t size, std::size_t offset);
+
+private:
+  /**
+   * @brief Buffer collecting small writes, blocks that do not fit are
+   * written together with the buffered data by a single writev() call
+   */
+  class BUFFER : public std::streambuf {
+  public:
+    BUFFER();
+    ~BUFFER();
+
+    /**
+     * @brief Sets the file descriptor the data is written to
+     *
+     * @param file file descriptor, -1 if there is none
+     */
+    void setFile(int file);
+
+  protected:
+    /**
+     * @brief Writes the full buffer and stores the next character
+     *
+     * @param c next character
+     * @return int_type c, eof if writing failed
+     */
+    int_type overflow(int_type c) override;
+
+    /**
+     * @brief Copies data into the buffer, or writes it directly behind the
+     * buffered data if it does not fit
+     *
+     * @param s data to be written
+     * @param n size of the data
+     * @return std::streamsize n, 0 if writing failed
+     */
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+    /**
+     * @brief Writes the buffered data to the file
+     *
+     * @return int 0 on success, -1 if writing failed
+     */
+    int sync() override;
+
+  private:
+    /**
+     * @brief Writes the buffered data followed by a block
+     *
+     * @param data block written behind the buffered data, may be null
+     * @param size size of the block
+     * @return true if everything was written
+     * @return false otherwise
+     */
+    bool drain(const char *data, std::size_t size);
+
+    /**
+     * @brief Writes several blocks, continuing after partial writes
+     *
+     * @param blocks blocks to be written, modified while writing
+     * @param count number of blocks
+     * @return true if everything was written
+     * @return false otherwise
+     */
+    bool writeBlocks(iovec *blocks, int count);
+
+    /**
+     * @brief File descriptor of the output file
+     */
+    int m_file;
+
+    /**
+     * @brief Buffered data
+     */
+    std::unique_ptr<char[]> m_data;
+  };
+
+  /**
+   * @brief Fsync files before they replace their target
+   */
+  static bool syncEnabled;
+
+  /**
+   * @brief Filename of the target
+   */
+  std::string m_filename;
+
+  /**
+   * @brief Filename of the temporary file, empty if the target is written
+   * directly
+   */
+  std::string m_temporary;
+
+  /**
+   * @brief File descriptor, -1 if the file is not open
+   */
+  int m_file;
+
+  /**
+   * @brief Buffer writing to #m_file
+   */
+  BUFFER m_buffer;
+};
+
+#endif